@@ -0,0 +1,316 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+// Measures the driver hot paths against an in-memory bus. Every benchmark
+// runs until it takes at least min_duration and reports the time and the
+// heap allocations per operation. The bus time section runs driver calls
+// once against simulated devices and reports the time a real bus would be
+// busy with them. The bus traffic budgets of the driver methods are checked
+// by the tests.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "chappi.h"
+#include "chappi_sim.h"
+
+static std::atomic<std::size_t> allocations{0};
+
+// Every replaced operator new allocates through allocate() and every
+// operator delete releases through deallocate(). Both stay out of line, so
+// the compiler never sees a malloc paired with a delete or a new paired
+// with a free.
+#if defined(_MSC_VER)
+#define BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+BENCHMARK_NOINLINE static void *allocate(std::size_t size) noexcept {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size ? size : 1);
+}
+BENCHMARK_NOINLINE static void deallocate(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void *operator new(std::size_t size) {
+  if (auto ptr = allocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+void *operator new[](std::size_t size) {
+  if (auto ptr = allocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size);
+}
+void operator delete(void *ptr) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  deallocate(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  deallocate(ptr);
+}
+
+template <typename Type> void do_not_optimize(const Type &value) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static const void *volatile sink;
+  sink = &value;
+#endif
+}
+
+static const auto min_duration = std::chrono::milliseconds(200);
+
+template <typename Function> void run(const char *name, Function &&fn) {
+  for (int i = 0; i < 16; ++i) {
+    fn();
+  }
+  std::size_t iterations{16};
+  for (;;) {
+    const auto allocations_start = allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+      fn();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto allocations_count = allocations.load() - allocations_start;
+    if (elapsed >= min_duration) {
+      const auto ns =
+          std::chrono::duration<double, std::nano>(elapsed).count() /
+          double(iterations);
+      std::printf("%-48s %12.1f ns/op %10.2f allocs/op\n", name, ns,
+                  double(allocations_count) / double(iterations));
+      return;
+    }
+    iterations *= 2;
+  }
+}
+
+// Registers live in memory, error makes every access fail with that code.
+template <typename ChipType> struct fake_bus {
+  using dev_addr_type = typename ChipType::dev_addr_type;
+  using addr_type = typename ChipType::addr_type;
+  using value_type = typename ChipType::value_type;
+
+  std::array<value_type, 256> regs{};
+  int error{};
+
+  void attach(ChipType &chip) {
+    chip.setup_io(
+        [this](dev_addr_type, addr_type addr, value_type &value) {
+          value = regs[std::size_t(addr) % regs.size()];
+          return error;
+        },
+        [this](dev_addr_type, addr_type addr, value_type value) {
+          regs[std::size_t(addr) % regs.size()] = value;
+          return error;
+        });
+  }
+};
+
+// Runs fn once and reports the transactions and bus time it took on device.
+template <typename DeviceType, typename Function>
+void bus_time(const char *name, DeviceType &device, Function &&fn) {
+  device.reset_counters();
+  fn();
+  std::printf("%-48s %12.1f us bus %10zu transactions\n", name,
+              std::chrono::duration<double, std::micro>(device.get_bus_time())
+                  .count(),
+              device.get_transactions());
+}
+
+using error_type = int;
+static const error_type no_error_v{error_type{0}};
+
+using hmc987_type = chappi::hmc987<error_type, no_error_v>;
+using hmc988_type = chappi::hmc988<error_type, no_error_v>;
+using ltc2991_type = chappi::ltc2991<error_type, no_error_v>;
+using si57x_type = chappi::si57x<error_type, no_error_v>;
+using lmx2594_type = chappi::lmx2594<error_type, no_error_v>;
+
+int main() {
+  std::printf("%-48s %15s %17s\n", "benchmark", "time", "allocations");
+
+  hmc987_type hmc987{};
+  fake_bus<hmc987_type> hmc987_bus{};
+  hmc987_bus.attach(hmc987);
+  run("chip_base::write", [&] { hmc987.write(0x01, 0x5A); });
+  run("chip_base::read", [&] {
+    hmc987_type::value_type value{};
+    hmc987.read(0x01, value);
+    do_not_optimize(value);
+  });
+
+  hmc988_type hmc988{};
+  fake_bus<hmc988_type> hmc988_bus{};
+  hmc988_bus.attach(hmc988);
+  run("noexcept_set_function, success", [&] {
+    error_type error{};
+    hmc988.set_delay_line_setpoint(30, error);
+    do_not_optimize(error);
+  });
+  hmc988_bus.error = 5;
+  run("noexcept_set_function, bus error", [&] {
+    error_type error{};
+    hmc988.set_delay_line_setpoint(30, error);
+    do_not_optimize(error);
+  });
+  run("throwing setter, bus error", [&] {
+    try {
+      hmc988.set_delay_line_setpoint(30);
+    } catch (const chappi::runtime_error<error_type> &e) {
+      do_not_optimize(e);
+    }
+  });
+  hmc988_bus.error = 0;
+
+  run("registers_update set/get/clear 16 registers", [] {
+    chappi::registers_update<113> update{};
+    for (std::size_t i = 0; i < 16; ++i) {
+      update.set_changed(i * 7);
+    }
+    while (update.is_changed()) {
+      const auto register_num = update.get_changed();
+      update.clear_changed(register_num);
+      do_not_optimize(register_num);
+    }
+  });
+
+  ltc2991_type ltc2991{};
+  fake_bus<ltc2991_type> ltc2991_bus{};
+  ltc2991_bus.attach(ltc2991);
+  run("ltc2991::get_data", [&] {
+    const auto data = ltc2991.get_data();
+    do_not_optimize(data);
+  });
+  run("ltc2991::get_data, noexcept_get_function", [&] {
+    error_type error{};
+    const auto data = ltc2991.get_data(error);
+    do_not_optimize(data);
+  });
+
+  si57x_type si57x{};
+  fake_bus<si57x_type> si57x_bus{};
+  si57x_bus.attach(si57x);
+  run("si57x::set_freq (_calculate_divider)",
+      [&] { si57x.set_freq(156.25e6); });
+
+  lmx2594_type lmx2594{};
+  fake_bus<lmx2594_type> lmx2594_bus{};
+  lmx2594_bus.attach(lmx2594);
+  // R110 reports the VCO as locked.
+  lmx2594_bus.regs[110] = 0x0400;
+  run("lmx2594::find_num_denom", [&] {
+    uint32_t numerator{};
+    uint32_t denomerator{};
+    lmx2594.find_num_denom(0.123456789, numerator, denomerator);
+    do_not_optimize(numerator);
+    do_not_optimize(denomerator);
+  });
+  chappi::lmx2594_output_frequency frequency{};
+  frequency.output = chappi::lmx2594_output::outa;
+  frequency.reference = 100e6;
+  frequency.frequency = 2.45e9;
+  run("lmx2594::set_frequency", [&] { lmx2594.set_frequency(frequency); });
+  // A whole profile programmed from an image file in memory.
+  chappi::register_images_writer writer{};
+  writer.add("LMX2594", "profile", 0, 0,
+             lmx2594.get_registers_map().array, 107, true, {0});
+  const auto image_data = writer.get_data();
+  const chappi::register_images images{image_data.data(), image_data.size()};
+  const auto image = images.find("LMX2594", 0, "profile");
+  run("chappi::load_image, lmx2594",
+      [&] { chappi::load_image(lmx2594, image); });
+
+  // The same profile as a TICS Pro export, parsed and loaded.
+  std::string tics_pro_dump{"[profile]\n"};
+  const auto profile_map = lmx2594.get_registers_map();
+  for (int register_num = 106; register_num >= 0; --register_num) {
+    char line[32];
+    const auto word = unsigned(register_num << 16) |
+                      profile_map.array[register_num];
+    std::snprintf(line, sizeof(line), "R%d\t0x%06X\n", register_num, word);
+    tics_pro_dump += line;
+  }
+  using lmx2594_dump = chappi::lmx2594_registers::register_dump;
+  auto load_dump = [&](const lmx2594_dump &dump) {
+    lmx2594.update_registers_map(dump.values, dump.registers);
+  };
+  run("chappi::register_dump_parser, lmx2594", [&] {
+    chappi::register_dump_reader<lmx2594_dump, decltype(load_dump) &> reader{
+        load_dump};
+    chappi::register_dump_parser<chappi::tics_pro_format, decltype(reader)>
+        parser{reader};
+    parser.feed(tics_pro_dump.data(), tics_pro_dump.size());
+    parser.finish();
+    reader.finish();
+  });
+
+  // I2C at 400 kHz and SPI at 10 MHz, each transaction costing a system call.
+  const auto i2c_timing =
+      chappi::sim_bus_timing::i2c(400e3, std::chrono::microseconds(20));
+  const auto spi_timing =
+      chappi::sim_bus_timing::spi(10e6, std::chrono::microseconds(5));
+
+  chappi::sim_ltc2991<error_type, no_error_v> ltc2991_sim{};
+  ltc2991_sim.set_timing(i2c_timing);
+  ltc2991_sim.attach(ltc2991);
+  bus_time("ltc2991::get_data, burst", ltc2991_sim,
+           [&] { do_not_optimize(ltc2991.get_data()); });
+  // Without block transfers the driver reads register by register.
+  ltc2991.setup_block_io({}, {});
+  bus_time("ltc2991::get_data, per register", ltc2991_sim,
+           [&] { do_not_optimize(ltc2991.get_data()); });
+
+  chappi::sim_lmx2594<error_type, no_error_v> lmx2594_sim{};
+  lmx2594_sim.set_timing(spi_timing);
+  lmx2594_sim.attach(lmx2594);
+  bus_time("lmx2594::reset, all registers", lmx2594_sim,
+           [&] { lmx2594.reset(); });
+  bus_time("lmx2594::update_output_power, changes only", lmx2594_sim, [&] {
+    lmx2594.update_output_power({chappi::lmx2594_output::outa, 31});
+  });
+  bus_time("lmx2594::set_frequency", lmx2594_sim,
+           [&] { lmx2594.set_frequency(frequency); });
+
+  return 0;
+}
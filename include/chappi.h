@@ -27,11 +27,16 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "chappi_ad5621.h"
 #include "chappi_adn4600.h"
+#include "chappi_async.h"
+#include "chappi_bus.h"
+#include "chappi_dump.h"
 #include "chappi_hmc987.h"
 #include "chappi_hmc988.h"
+#include "chappi_image.h"
 #include "chappi_ina219.h"
 #include "chappi_lmx2594.h"
 #include "chappi_ltc2991.h"
 #include "chappi_ltc6953.h"
 #include "chappi_si57x.h"
 #include "chappi_tca6424.h"
+#include "chappi_transaction.h"
@@ -40,8 +40,8 @@ namespace detail {
 } // namespace detail
 
 template <typename ErrorType = int, ErrorType NoerrorValue = 0,
-    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint16_t>
-class adn4600 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint16_t, typename IoPolicy = dynamic_io>
+class adn4600 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy> {
     static constexpr auto _chip_name = "ADN4600";
     detail::adn4600_counter _counter;
 
@@ -52,8 +52,9 @@ public:
     {
     }
     adn4600(std::streambuf* buf_ptr = {}, reg_read_fn reg_read = {}, reg_write_fn reg_write = {}, dev_addr_type dev_addr = {})
-        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type> { buf_ptr, reg_read, reg_write, dev_addr }
+        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type, IoPolicy> { buf_ptr, reg_read, reg_write, dev_addr }
     {
+        set_name(_chip_name, get_num());
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
@@ -66,7 +67,7 @@ public:
     }
     int get_num() const noexcept final { return _counter.get_num(); }
     int get_counts() const noexcept final { return _counter.get_counts(); }
-    std::string get_name() const noexcept final { return get_name(_chip_name, get_num()); }
+    std::string get_name() const noexcept final { return get_name_cstr(); }
     void reset() const
     {
 #if defined(CHAPPI_LOG_ENABLE)
@@ -88,7 +89,7 @@ public:
     }
     void xpt_config(const adn4600_xpt_data& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<adn4600, error_type, NoerrorValue, adn4600_xpt_data, &adn4600::xpt_config>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { xpt_config(data); });
     }
     void xpt_update() const
     {
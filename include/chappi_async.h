@@ -0,0 +1,222 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <optional>
+#define CHAPPI_COROUTINES 1
+#endif
+
+#include "chappi_base.h"
+
+namespace chappi {
+
+// An executor is any type with post(std::function<void()>) that runs the
+// posted jobs in order. A chip is not safe for concurrent use, so all async
+// calls of one chip have to go through the same executor. Chips on different
+// buses get different executors and their transfers overlap.
+
+class inline_executor {
+public:
+    void post(const std::function<void()>& job) { job(); }
+};
+
+class worker_executor {
+public:
+    worker_executor()
+        : _thread { [this] { _run(); } }
+    {
+    }
+    worker_executor(const worker_executor&) = delete;
+    worker_executor& operator=(const worker_executor&) = delete;
+    // Runs the jobs already posted, then stops the worker.
+    ~worker_executor() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock { _mutex };
+            _stopped = true;
+        }
+        _cv.notify_one();
+        _thread.join();
+    }
+    void post(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock { _mutex };
+            _jobs.push_back(std::move(job));
+        }
+        _cv.notify_one();
+    }
+    bool is_worker_thread() const noexcept { return std::this_thread::get_id() == _thread.get_id(); }
+
+private:
+    void _run()
+    {
+        std::unique_lock<std::mutex> lock { _mutex };
+        for (;;) {
+            _cv.wait(lock, [this] { return _stopped || !_jobs.empty(); });
+            if (_jobs.empty()) {
+                return;
+            }
+            auto job = std::move(_jobs.front());
+            _jobs.pop_front();
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+    }
+
+    std::mutex _mutex {};
+    std::condition_variable _cv {};
+    std::deque<std::function<void()>> _jobs {};
+    bool _stopped {};
+    std::thread _thread;
+};
+
+// Runs fn on the executor. The result or the exception thrown by fn is
+// delivered through the returned future.
+template <typename Executor, typename Function>
+auto async_invoke(Executor& executor, Function&& fn) -> std::future<decltype(fn())>
+{
+    using result_type = decltype(fn());
+    auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<Function>(fn));
+    auto result = task->get_future();
+    executor.post([task] { (*task)(); });
+    return result;
+}
+
+template <typename Executor, typename ChipType>
+std::future<typename ChipType::value_type> async_read(Executor& executor, const ChipType& chip, typename ChipType::addr_type addr)
+{
+    return async_invoke(executor, [&chip, addr] {
+        typename ChipType::value_type value {};
+        chip.read(addr, value);
+        return value;
+    });
+}
+
+template <typename Executor, typename ChipType>
+std::future<void> async_write(Executor& executor, const ChipType& chip, typename ChipType::addr_type addr, typename ChipType::value_type value)
+{
+    return async_invoke(executor, [&chip, addr, value] { chip.write(addr, value); });
+}
+
+// The caller keeps values alive until the future is ready.
+template <typename Executor, typename ChipType>
+std::future<void> async_read_block(Executor& executor, const ChipType& chip, typename ChipType::addr_type addr,
+    typename ChipType::value_type* values, std::size_t count)
+{
+    return async_invoke(executor, [&chip, addr, values, count] { chip.read_block(addr, values, count); });
+}
+
+template <typename Executor, typename ChipType>
+std::future<void> async_write_block(Executor& executor, const ChipType& chip, typename ChipType::addr_type addr,
+    const typename ChipType::value_type* values, std::size_t count)
+{
+    return async_invoke(executor, [&chip, addr, values, count] { chip.write_block(addr, values, count); });
+}
+
+#if defined(CHAPPI_COROUTINES)
+
+namespace detail {
+    template <typename Type>
+    class async_result {
+    public:
+        template <typename Function>
+        void run(Function& fn) { _value.emplace(fn()); }
+        Type get() { return std::move(*_value); }
+
+    private:
+        std::optional<Type> _value {};
+    };
+    template <>
+    class async_result<void> {
+    public:
+        template <typename Function>
+        void run(Function& fn) { fn(); }
+        void get() noexcept { }
+    };
+} // namespace detail
+
+// co_await invoke_on(executor, fn) runs fn on the executor and resumes the
+// coroutine there with the result, so no thread is blocked while waiting.
+template <typename Executor, typename Function>
+class invoke_on {
+    using result_type = decltype(std::declval<Function&>()());
+
+public:
+    invoke_on(Executor& executor, Function fn)
+        : _executor { executor }
+        , _fn { std::move(fn) }
+    {
+    }
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        _executor.post([this, handle] {
+#if CHAPPI_EXCEPTIONS
+            try {
+                _result.run(_fn);
+            } catch (...) {
+                _error = std::current_exception();
+            }
+#else
+            _result.run(_fn);
+#endif
+            handle.resume();
+        });
+    }
+    result_type await_resume()
+    {
+        if (_error) {
+            std::rethrow_exception(_error);
+        }
+        return _result.get();
+    }
+
+private:
+    Executor& _executor;
+    Function _fn;
+    detail::async_result<result_type> _result {};
+    std::exception_ptr _error {};
+};
+
+#endif
+
+} // namespace chappi
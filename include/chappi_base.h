@@ -25,18 +25,47 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include "chappi_except.h"
+#include "chappi_stats.h"
+#include "chappi_trace.h"
 
 #if __cplusplus < 201103L
 #error \    "This file requires compiler and library support for the ISO C++ 2011 standard or later."
 #endif
 
+// CHAPPI_LOG_LEVEL sets which logging is compiled in: driver calls at
+// CHAPPI_LOG_LEVEL_INFO, register accesses as well at CHAPPI_LOG_LEVEL_IO.
+// Defining CHAPPI_LOG_ENABLE alone keeps logging everything.
+#define CHAPPI_LOG_LEVEL_NONE 0
+#define CHAPPI_LOG_LEVEL_INFO 1
+#define CHAPPI_LOG_LEVEL_IO 2
+
+#if !defined(CHAPPI_LOG_LEVEL)
+#if defined(CHAPPI_LOG_ENABLE)
+#define CHAPPI_LOG_LEVEL CHAPPI_LOG_LEVEL_IO
+#else
+#define CHAPPI_LOG_LEVEL CHAPPI_LOG_LEVEL_NONE
+#endif
+#elif CHAPPI_LOG_LEVEL > CHAPPI_LOG_LEVEL_NONE && !defined(CHAPPI_LOG_ENABLE)
+#define CHAPPI_LOG_ENABLE
+#endif
+
 namespace chappi {
 
 class logstream {
@@ -62,7 +91,7 @@ public:
         return *this;
     }
     void set_enabled(bool enabled) noexcept { _enabled = enabled; }
-    bool is_enabled() const noexcept { return _enabled; }
+    bool is_enabled() const noexcept { return _enabled && _log->rdbuf(); }
 };
 
 namespace helpers {
@@ -72,25 +101,19 @@ namespace helpers {
         typename GetType, base_get_functor<ClassType, GetType> functor>
     GetType noexcept_get_function(const ClassType* const _this, ErrorType& error) noexcept
     {
-        GetType retval;
-        try {
-            (_this->*functor)(retval);
-            error = NoerrorValue;
-        } catch (const runtime_error<ErrorType>& e) {
-            error = e.get_error();
-        }
+        GetType retval {};
+        detail::error_latch_scope<ErrorType> latch {};
+        (_this->*functor)(retval);
+        error = latch.get_error(NoerrorValue);
         return retval;
     }
     template <typename ClassType, typename ErrorType, ErrorType NoerrorValue,
         typename GetType, base_get_functor<ClassType, GetType> functor>
     void noexcept_get_function(const ClassType* const _this, GetType& retval, ErrorType& error) noexcept
     {
-        try {
-            (_this->*functor)(retval);
-            error = NoerrorValue;
-        } catch (const runtime_error<ErrorType>& e) {
-            error = e.get_error();
-        }
+        detail::error_latch_scope<ErrorType> latch {};
+        (_this->*functor)(retval);
+        error = latch.get_error(NoerrorValue);
     }
     template <typename ClassType, typename SetType>
     using base_set_functor = void (ClassType::*)(SetType) const;
@@ -98,24 +121,25 @@ namespace helpers {
         typename SetType, base_set_functor<ClassType, SetType> functor>
     void noexcept_set_function(const ClassType* const _this, SetType setval, ErrorType& error) noexcept
     {
-        try {
-            (_this->*functor)(setval);
-            error = NoerrorValue;
-        } catch (const runtime_error<ErrorType>& e) {
-            error = e.get_error();
-        }
+        detail::error_latch_scope<ErrorType> latch {};
+        (_this->*functor)(setval);
+        error = latch.get_error(NoerrorValue);
     }
     template <typename ClassType>
     using base_void_functor = void (ClassType::*)() const;
     template <typename ClassType, typename ErrorType, ErrorType NoerrorValue, base_void_functor<ClassType> functor>
     void noexcept_void_function(const ClassType* const _this, ErrorType& error) noexcept
     {
-        try {
-            (_this->*functor)();
-            error = NoerrorValue;
-        } catch (const runtime_error<ErrorType>& e) {
-            error = e.get_error();
-        }
+        detail::error_latch_scope<ErrorType> latch {};
+        (_this->*functor)();
+        error = latch.get_error(NoerrorValue);
+    }
+    // The same for any call, fn() may take arguments and return a value.
+    template <typename ErrorType, ErrorType NoerrorValue, typename Function>
+    auto noexcept_invoke(ErrorType& error, Function&& fn) noexcept -> decltype(fn())
+    {
+        const detail::error_latch_guard<ErrorType> latch { error, NoerrorValue };
+        return fn();
     }
 
 } // namespace helpers
@@ -123,9 +147,9 @@ namespace helpers {
 template <typename ClassType>
 class chips_counter {
 #if __cplusplus < 201703L
-    static int _counts;
+    static std::atomic<int> _counts;
 #else
-    inline static int _counts { -1 };
+    inline static std::atomic<int> _counts { -1 };
 #endif
 
     int _num { -1 };
@@ -133,9 +157,8 @@ class chips_counter {
 public:
     using owner_type = ClassType;
     chips_counter()
+        : _num { ++_counts }
     {
-        ++_counts;
-        _num = _counts;
     }
     ~chips_counter() { --_counts; }
     int get_counts() const { return _counts; }
@@ -144,43 +167,445 @@ public:
 
 #if __cplusplus < 201703L
 template <typename ClassType>
-int chips_counter<ClassType>::_counts { -1 };
+std::atomic<int> chips_counter<ClassType>::_counts { -1 };
+#endif
+
+namespace detail {
+    // Drivers that keep shadow state lock it with driver_lock, chip_base
+    // locks its register cache and transaction state the same way. Defining
+    // CHAPPI_THREAD_SAFE makes one chip instance usable from several threads,
+    // otherwise the lock compiles to nothing. The lock is recursive and
+    // waiters sleep until it is released, a bus transfer of another thread
+    // costs them no CPU. lock() never throws, so noexcept members may take
+    // it: recursion is counted here and the inner std::mutex is only locked
+    // once per thread, it can only fail on a broken system, which
+    // terminates. Drivers hold the lock for register computation and bus
+    // accesses, never across delays or polling.
+#if defined(CHAPPI_THREAD_SAFE)
+    class driver_mutex {
+    public:
+        void lock() noexcept
+        {
+            const auto self = std::this_thread::get_id();
+            if (_owner.load(std::memory_order_relaxed) == self) {
+                ++_depth;
+                return;
+            }
+            std::unique_lock<std::mutex> lock { _mutex };
+            _released.wait(lock, [this] { return _owner.load(std::memory_order_relaxed) == std::thread::id {}; });
+            _owner.store(self, std::memory_order_relaxed);
+            _depth = 1;
+        }
+        void unlock() noexcept
+        {
+            if (--_depth != 0) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock { _mutex };
+                _owner.store(std::thread::id {}, std::memory_order_relaxed);
+            }
+            _released.notify_one();
+        }
+
+    private:
+        std::mutex _mutex {};
+        std::condition_variable _released {};
+        std::atomic<std::thread::id> _owner {};
+        unsigned _depth {};
+    };
+#else
+    struct driver_mutex {
+        void lock() noexcept { }
+        void unlock() noexcept { }
+    };
 #endif
+    using driver_lock = std::lock_guard<driver_mutex>;
+    using driver_unique_lock = std::unique_lock<driver_mutex>;
+} // namespace detail
+
+struct dynamic_io {
+};
+
+template <typename AddrType, typename ValueType>
+struct reg_data {
+    AddrType addr {};
+    ValueType value {};
+};
+
+enum class cache_mode {
+    disabled,
+    write_through,
+    write_back
+};
+
+// How a chip repeats bus accesses that fail. The default makes a single
+// attempt. A failed access is repeated up to attempts - 1 times while
+// is_retryable(error) holds (every error when it is empty), waiting backoff
+// before the first repeat and multiplying the wait by backoff_factor up to
+// backoff_max before each next one. Under CHAPPI_THREAD_SAFE other threads
+// use the chip during the wait, unless a driver lock around the access, as
+// in the lmx2594 update_* methods, keeps them out.
+template <typename ErrorType>
+struct retry_policy {
+    unsigned attempts { 1 };
+    std::chrono::microseconds backoff {};
+    unsigned backoff_factor { 2 };
+    std::chrono::microseconds backoff_max { 10000 };
+    std::function<bool(ErrorType)> is_retryable {};
+};
+
+template <typename ChipType, std::size_t Capacity>
+class transaction;
+
+namespace detail {
+    template <typename AddrType, typename ValueType>
+    class write_capture {
+    public:
+        virtual void capture_write(AddrType addr, ValueType value) = 0;
+        virtual bool captured_read(AddrType addr, ValueType& value) const noexcept = 0;
+
+    protected:
+        ~write_capture() = default;
+    };
+
+    template <typename ErrorType, ErrorType NoerrorValue, typename IoType, typename DevAddrType, typename AddrType, typename ValueType>
+    auto io_read_block(const IoType& io, DevAddrType dev_addr, AddrType addr, ValueType* values, std::size_t count, int)
+        -> decltype(io.read_block(dev_addr, addr, values, count))
+    {
+        return io.read_block(dev_addr, addr, values, count);
+    }
+    template <typename ErrorType, ErrorType NoerrorValue, typename IoType, typename DevAddrType, typename AddrType, typename ValueType>
+    ErrorType io_read_block(const IoType& io, DevAddrType dev_addr, AddrType addr, ValueType* values, std::size_t count, long)
+    {
+        ErrorType error { NoerrorValue };
+        for (std::size_t i {}; i < count && error == NoerrorValue; ++i) {
+            error = io.read(dev_addr, AddrType(addr + i), values[i]);
+        }
+        return error;
+    }
+    template <typename ErrorType, ErrorType NoerrorValue, typename IoType, typename DevAddrType, typename AddrType, typename ValueType>
+    auto io_write_block(const IoType& io, DevAddrType dev_addr, AddrType addr, const ValueType* values, std::size_t count, int)
+        -> decltype(io.write_block(dev_addr, addr, values, count))
+    {
+        return io.write_block(dev_addr, addr, values, count);
+    }
+    template <typename ErrorType, ErrorType NoerrorValue, typename IoType, typename DevAddrType, typename AddrType, typename ValueType>
+    ErrorType io_write_block(const IoType& io, DevAddrType dev_addr, AddrType addr, const ValueType* values, std::size_t count, long)
+    {
+        ErrorType error { NoerrorValue };
+        for (std::size_t i {}; i < count && error == NoerrorValue; ++i) {
+            error = io.write(dev_addr, AddrType(addr + i), values[i]);
+        }
+        return error;
+    }
+
+    // Splits a batch into runs of consecutive addresses and sends each run as a block.
+    template <typename ErrorType, ErrorType NoerrorValue, typename IoType, typename DevAddrType, typename AddrType, typename ValueType>
+    ErrorType write_runs(const IoType& io, DevAddrType dev_addr, const reg_data<AddrType, ValueType>* data, std::size_t count)
+    {
+        const std::size_t run_max { 64 };
+        ValueType values[run_max];
+        ErrorType error { NoerrorValue };
+        std::size_t i {};
+        while (i < count && error == NoerrorValue) {
+            std::size_t run { 1 };
+            values[0] = data[i].value;
+            while (i + run < count && run < run_max && data[i + run].addr == AddrType(data[i].addr + run)) {
+                values[run] = data[i + run].value;
+                ++run;
+            }
+            if (run == 1) {
+                error = io.write(dev_addr, data[i].addr, data[i].value);
+            } else {
+                error = io_write_block<ErrorType, NoerrorValue>(io, dev_addr, data[i].addr, values, run, 0);
+            }
+            i += run;
+        }
+        return error;
+    }
+
+    template <typename ErrorType, ErrorType NoerrorValue, typename IoType, typename DevAddrType, typename AddrType, typename ValueType>
+    auto io_write_batch(const IoType& io, DevAddrType dev_addr, const reg_data<AddrType, ValueType>* data, std::size_t count, int)
+        -> decltype(io.write_batch(dev_addr, data, count))
+    {
+        return io.write_batch(dev_addr, data, count);
+    }
+    template <typename ErrorType, ErrorType NoerrorValue, typename IoType, typename DevAddrType, typename AddrType, typename ValueType>
+    ErrorType io_write_batch(const IoType& io, DevAddrType dev_addr, const reg_data<AddrType, ValueType>* data, std::size_t count, long)
+    {
+        return write_runs<ErrorType, NoerrorValue>(io, dev_addr, data, count);
+    }
+
+    template <typename ErrorType, ErrorType NoerrorValue, typename DevAddrType, typename AddrType, typename ValueType>
+    class function_io {
+    public:
+        using reg_read_fn = std::function<ErrorType(DevAddrType, AddrType, ValueType&)>;
+        using reg_write_fn = std::function<ErrorType(DevAddrType, AddrType, ValueType)>;
+        using reg_read_block_fn = std::function<ErrorType(DevAddrType, AddrType, ValueType*, std::size_t)>;
+        using reg_write_block_fn = std::function<ErrorType(DevAddrType, AddrType, const ValueType*, std::size_t)>;
+        using reg_write_batch_fn = std::function<ErrorType(DevAddrType, const reg_data<AddrType, ValueType>*, std::size_t)>;
+        function_io() = default;
+        function_io(const reg_read_fn& reg_read, const reg_write_fn& reg_write)
+            : _reg_read { reg_read }
+            , _reg_write { reg_write }
+        {
+        }
+        ErrorType read(DevAddrType dev_addr, AddrType addr, ValueType& value) const
+        {
+            return _reg_read(dev_addr, addr, value);
+        }
+        ErrorType write(DevAddrType dev_addr, AddrType addr, ValueType value) const
+        {
+            return _reg_write(dev_addr, addr, value);
+        }
+        ErrorType read_block(DevAddrType dev_addr, AddrType addr, ValueType* values, std::size_t count) const
+        {
+            if (_reg_read_block) {
+                return _reg_read_block(dev_addr, addr, values, count);
+            }
+            ErrorType error { NoerrorValue };
+            for (std::size_t i {}; i < count && error == NoerrorValue; ++i) {
+                error = _reg_read(dev_addr, AddrType(addr + i), values[i]);
+            }
+            return error;
+        }
+        ErrorType write_block(DevAddrType dev_addr, AddrType addr, const ValueType* values, std::size_t count) const
+        {
+            if (_reg_write_block) {
+                return _reg_write_block(dev_addr, addr, values, count);
+            }
+            ErrorType error { NoerrorValue };
+            for (std::size_t i {}; i < count && error == NoerrorValue; ++i) {
+                error = _reg_write(dev_addr, AddrType(addr + i), values[i]);
+            }
+            return error;
+        }
+        ErrorType write_batch(DevAddrType dev_addr, const reg_data<AddrType, ValueType>* data, std::size_t count) const
+        {
+            if (_reg_write_batch) {
+                return _reg_write_batch(dev_addr, data, count);
+            }
+            return write_runs<ErrorType, NoerrorValue>(*this, dev_addr, data, count);
+        }
+        void setup(const reg_read_fn& reg_read, const reg_write_fn& reg_write)
+        {
+            _reg_read = reg_read;
+            _reg_write = reg_write;
+        }
+        void setup_block(const reg_read_block_fn& reg_read_block, const reg_write_block_fn& reg_write_block)
+        {
+            _reg_read_block = reg_read_block;
+            _reg_write_block = reg_write_block;
+        }
+        void setup_batch(const reg_write_batch_fn& reg_write_batch)
+        {
+            _reg_write_batch = reg_write_batch;
+        }
+
+    private:
+        reg_read_fn _reg_read {};
+        reg_write_fn _reg_write {};
+        reg_read_block_fn _reg_read_block {};
+        reg_write_block_fn _reg_write_block {};
+        reg_write_batch_fn _reg_write_batch {};
+    };
 
-#define CHIP_BASE_RESOLVE                                                                               \
-    using typename chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::error_type;    \
-    using typename chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::dev_addr_type; \
-    using typename chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::addr_type;     \
-    using typename chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::value_type;    \
-    using typename chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::reg_read_fn;   \
-    using typename chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::reg_write_fn;  \
-    using chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::no_error_value;         \
-    using chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::chip_base;              \
-    using chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::get_name;               \
-    using chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::read;                   \
-    using chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::write;                  \
-    using chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::log;                    \
-    using chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::log_info;               \
-    using chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::log_set_enabled;        \
-    using chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::log_is_enabled;         \
-    using chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::set_dev_addr;           \
-    using chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::get_dev_addr;
+    template <typename IoPolicy, typename ErrorType, ErrorType NoerrorValue, typename DevAddrType, typename AddrType, typename ValueType>
+    struct io_policy {
+        using type = IoPolicy;
+    };
+    template <typename ErrorType, ErrorType NoerrorValue, typename DevAddrType, typename AddrType, typename ValueType>
+    struct io_policy<dynamic_io, ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+        using type = function_io<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>;
+    };
 
+    template <typename IoType, typename ReadFn, typename WriteFn>
+    std::enable_if_t<std::is_constructible<IoType, const ReadFn&, const WriteFn&>::value, IoType>
+    make_io(const ReadFn& reg_read, const WriteFn& reg_write)
+    {
+        return IoType { reg_read, reg_write };
+    }
+    template <typename IoType, typename ReadFn, typename WriteFn>
+    std::enable_if_t<!std::is_constructible<IoType, const ReadFn&, const WriteFn&>::value, IoType>
+    make_io(const ReadFn&, const WriteFn&)
+    {
+        return IoType {};
+    }
+
+    // Shadow copy of the chip registers kept by chip_base. Registers past the
+    // cache size and the ones marked volatile are never cached.
+    template <typename AddrType, typename ValueType>
+    class register_cache {
+        enum : unsigned char {
+            _valid = 0x01,
+            _dirty = 0x02,
+            _volatile = 0x04
+        };
+
+    public:
+        void setup(cache_mode mode, std::size_t size)
+        {
+            _mode = mode;
+            if (mode == cache_mode::disabled) {
+                size = 0;
+            }
+            _values.assign(size, ValueType {});
+            _flags.assign(size, 0);
+        }
+        cache_mode get_mode() const noexcept { return _mode; }
+        std::size_t size() const noexcept { return _flags.size(); }
+        void set_volatile(AddrType addr, std::size_t count, bool is_volatile) noexcept
+        {
+            for (std::size_t i {}; i < count && std::size_t(addr) + i < size(); ++i) {
+                // A volatile register keeps a pending dirty value but no
+                // longer a valid one, the chip may change it from now on.
+                auto& flags = _flags[std::size_t(addr) + i];
+                flags = (is_volatile) ? ((flags & _dirty) | _volatile) : (flags & ~_volatile);
+            }
+        }
+        bool is_cached(AddrType addr) const noexcept
+        {
+            return std::size_t(addr) < size() && !(_flags[std::size_t(addr)] & _volatile);
+        }
+        bool holds_back(AddrType addr) const noexcept
+        {
+            return _mode == cache_mode::write_back && is_cached(addr);
+        }
+        bool load(AddrType addr, ValueType& value) const noexcept
+        {
+            if (!is_cached(addr) || !(_flags[std::size_t(addr)] & _valid)) {
+                return false;
+            }
+            value = _values[std::size_t(addr)];
+            return true;
+        }
+        bool load_dirty(AddrType addr, ValueType& value) const noexcept
+        {
+            if (!is_cached(addr) || !(_flags[std::size_t(addr)] & _dirty)) {
+                return false;
+            }
+            value = _values[std::size_t(addr)];
+            return true;
+        }
+        void store(AddrType addr, ValueType value, bool dirty = false) noexcept
+        {
+            if (is_cached(addr)) {
+                _values[std::size_t(addr)] = value;
+                _flags[std::size_t(addr)] = (dirty) ? (_valid | _dirty) : _valid;
+            }
+        }
+        // Records a value written to the chip. A different dirty value stored
+        // by another thread while the write was backing off is newer and
+        // stays pending.
+        void store_written(AddrType addr, ValueType value) noexcept
+        {
+            ValueType dirty_value {};
+            if (!load_dirty(addr, dirty_value) || dirty_value == value) {
+                store(addr, value);
+            }
+        }
+        void invalidate() noexcept
+        {
+            for (auto& flags : _flags) {
+                flags &= _volatile;
+            }
+        }
+        // Collects up to count dirty registers starting from addr and returns
+        // the address to continue from.
+        std::size_t collect_dirty(std::size_t addr, reg_data<AddrType, ValueType>* data, std::size_t& count) const noexcept
+        {
+            const auto max_count = count;
+            count = 0;
+            for (; addr < size() && count < max_count; ++addr) {
+                if (_flags[addr] & _dirty) {
+                    data[count].addr = AddrType(addr);
+                    data[count].value = _values[addr];
+                    ++count;
+                }
+            }
+            return addr;
+        }
+
+    private:
+        cache_mode _mode { cache_mode::disabled };
+        std::vector<ValueType> _values {};
+        std::vector<unsigned char> _flags {};
+    };
+
+} // namespace detail
+
+#define CHIP_BASE_TYPE chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy>
+
+#define CHIP_BASE_RESOLVE                              \
+    using typename CHIP_BASE_TYPE::error_type;         \
+    using typename CHIP_BASE_TYPE::dev_addr_type;      \
+    using typename CHIP_BASE_TYPE::addr_type;          \
+    using typename CHIP_BASE_TYPE::value_type;         \
+    using typename CHIP_BASE_TYPE::io_type;            \
+    using typename CHIP_BASE_TYPE::reg_read_fn;        \
+    using typename CHIP_BASE_TYPE::reg_write_fn;       \
+    using typename CHIP_BASE_TYPE::reg_read_block_fn;  \
+    using typename CHIP_BASE_TYPE::reg_write_block_fn; \
+    using typename CHIP_BASE_TYPE::reg_write_batch_fn; \
+    using typename CHIP_BASE_TYPE::reg_data_type;      \
+    using CHIP_BASE_TYPE::no_error_value;              \
+    using CHIP_BASE_TYPE::chip_base;                   \
+    using CHIP_BASE_TYPE::get_name;                    \
+    using CHIP_BASE_TYPE::get_name_cstr;               \
+    using CHIP_BASE_TYPE::set_name;                    \
+    using CHIP_BASE_TYPE::read;                        \
+    using CHIP_BASE_TYPE::write;                       \
+    using CHIP_BASE_TYPE::read_block;                  \
+    using CHIP_BASE_TYPE::write_block;                 \
+    using CHIP_BASE_TYPE::write_batch;                 \
+    using CHIP_BASE_TYPE::log;                         \
+    using CHIP_BASE_TYPE::log_info;                    \
+    using CHIP_BASE_TYPE::log_set_enabled;             \
+    using CHIP_BASE_TYPE::log_is_enabled;              \
+    using CHIP_BASE_TYPE::set_dev_addr;                \
+    using CHIP_BASE_TYPE::get_dev_addr;                \
+    using CHIP_BASE_TYPE::get_io;                      \
+    using CHIP_BASE_TYPE::setup_cache;                 \
+    using CHIP_BASE_TYPE::get_cache_mode;              \
+    using CHIP_BASE_TYPE::set_volatile;                \
+    using CHIP_BASE_TYPE::is_volatile;                 \
+    using CHIP_BASE_TYPE::invalidate_cache;            \
+    using CHIP_BASE_TYPE::flush_cache;                 \
+    using CHIP_BASE_TYPE::set_retry_policy;            \
+    using CHIP_BASE_TYPE::get_retry_policy;            \
+    using CHIP_BASE_TYPE::try_read;                    \
+    using CHIP_BASE_TYPE::try_write;                   \
+    using CHIP_BASE_TYPE::try_invoke;                  \
+    using CHIP_BASE_TYPE::raise_error;                 \
+    using CHIP_BASE_TYPE::error_raised;
+
+// IoPolicy selects how register access reaches the bus: dynamic_io keeps the
+// std::function callbacks installed by setup_io(), any other type is used as is
+// and must provide read(dev_addr, addr, value&) and write(dev_addr, addr, value)
+// returning ErrorType, so the calls can be inlined into the drivers. A policy
+// may also provide read_block()/write_block() for consecutive registers,
+// otherwise block transfers fall back to one access per register. Likewise an
+// optional write_batch() takes a list of arbitrary registers at once, without
+// it the list is split into blocks of consecutive addresses.
 template <typename ErrorType, ErrorType NoerrorValue,
-    typename DevAddrType, typename AddrType, typename ValueType>
+    typename DevAddrType, typename AddrType, typename ValueType, typename IoPolicy = dynamic_io>
 class chip_base {
-    template <typename return_type = ErrorType>
-    using _reg_read_fn = std::function<return_type(DevAddrType, AddrType, ValueType&)>;
-    template <typename return_type = ErrorType>
-    using _reg_write_fn = std::function<return_type(DevAddrType, AddrType, ValueType)>;
+    using _function_io = detail::function_io<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>;
 
 public:
     using error_type = ErrorType;
     using value_type = ValueType;
     using addr_type = AddrType;
     using dev_addr_type = DevAddrType;
-    using reg_read_fn = _reg_read_fn<error_type>;
-    using reg_write_fn = _reg_write_fn<error_type>;
+    using io_type = typename detail::io_policy<IoPolicy, ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>::type;
+    using reg_read_fn = typename _function_io::reg_read_fn;
+    using reg_write_fn = typename _function_io::reg_write_fn;
+    using reg_read_block_fn = typename _function_io::reg_read_block_fn;
+    using reg_write_block_fn = typename _function_io::reg_write_block_fn;
+    using reg_write_batch_fn = typename _function_io::reg_write_batch_fn;
+    using reg_data_type = reg_data<addr_type, value_type>;
+    using retry_policy_type = retry_policy<error_type>;
 
 protected:
     mutable logstream log;
@@ -194,11 +619,13 @@ protected:
         : log { buf_ptr }
         , no_error_value { NoerrorValue }
         , _dev_addr { dev_addr }
-        , _reg_read { reg_read }
-        , _reg_write { reg_write }
+        , _io { detail::make_io<io_type>(reg_read, reg_write) }
     {
     }
     virtual ~chip_base() noexcept = default;
+    // The "<CHIP>-<num>" name, set once by the driver constructor so logging
+    // does not build it again.
+    const char* get_name_cstr() const noexcept { return _name; }
     std::string get_name(const std::string& chip_name, int count) const
     {
         std::string name {};
@@ -207,13 +634,39 @@ protected:
         name += std::to_string(get_num());
         return name;
     }
-#if defined(CHAPPI_LOG_ENABLE)
+    void set_name(const char* chip_name, int num) noexcept
+    {
+        std::snprintf(_name, sizeof(_name), "%s-%d", chip_name, num);
+    }
+    // Drivers report failures through raise_error(): it throws, or latches
+    // the error while an error_type& overload or try_invoke() is running.
+    // After a latched error the bus is not touched again, drivers check
+    // error_raised() to leave polling loops and delays early.
+    template <typename Exception>
+    void raise_error(Exception&& exception) const
+    {
+        detail::raise_error<error_type>(std::forward<Exception>(exception));
+    }
+    bool error_raised() const noexcept
+    {
+        return detail::is_error_raised<error_type>();
+    }
+#if CHAPPI_LOG_LEVEL >= CHAPPI_LOG_LEVEL_INFO
+    void log_info(const char* message) const noexcept
+    {
+        if (log.is_enabled()) {
+            log << '[' << _name << "] " << message << '\n';
+        }
+    }
     void log_info(const std::string& message) const noexcept
     {
-        log << '[' << get_name() << "] " << message << '\n';
+        log_info(message.c_str());
     }
 #else
-    void log_info(const std::string& message) const noexcept
+    void log_info(const char*) const noexcept
+    {
+    }
+    void log_info(const std::string&) const noexcept
     {
     }
 #endif
@@ -227,47 +680,574 @@ public:
     void write(addr_type addr, value_type value) const
     {
         static const char error_msg[] { "chip reg write error" };
-        error_type error = _reg_write(_dev_addr, addr, value);
-#if defined(CHAPPI_LOG_ENABLE)
-        log << '[' << get_name() << ']' << " <W> DEV:" << +_dev_addr << " | REG:" << +addr << " | VAL:" << +value << '\n';
-#endif
+        if (error_raised()) {
+            return;
+        }
+        detail::driver_lock lock { _io_mutex };
+        if (const auto capture = _active_capture()) {
+            capture->capture_write(addr, value);
+            return;
+        }
+        const error_type error = _cached_write(addr, value);
         if (error != no_error_value)
-            throw runtime_error<error_type>(error, error_msg);
+            detail::raise_error(error, error_msg);
     }
     void read(addr_type addr, value_type& value) const
     {
         static const char error_msg[] { "chip reg read error" };
-        error_type error = _reg_read(_dev_addr, addr, value);
-#if defined(CHAPPI_LOG_ENABLE)
-        log << '[' << get_name() << ']' << " <R> DEV:" << +_dev_addr << " | REG:" << +addr << " | VAL:" << +value << '\n';
-#endif
+        if (error_raised()) {
+            return;
+        }
+        detail::driver_lock lock { _io_mutex };
+        const auto capture = _active_capture();
+        if (capture && capture->captured_read(addr, value)) {
+            return;
+        }
+        const error_type error = _cached_read(addr, value);
         if (error != no_error_value)
-            throw runtime_error<error_type>(error, error_msg);
+            detail::raise_error(error, error_msg);
     }
     void write(addr_type addr, value_type value, error_type& error) const noexcept
     {
-        error = _reg_write(_dev_addr, addr, value);
+        detail::driver_lock lock { _io_mutex };
+        if (const auto capture = _active_capture()) {
+            detail::error_latch_scope<error_type> latch {};
+            capture->capture_write(addr, value);
+            error = latch.get_error(no_error_value);
+            return;
+        }
+        error = _cached_write(addr, value);
     }
     void read(addr_type addr, value_type& value, error_type& error) const noexcept
     {
-        error = _reg_read(_dev_addr, addr, value);
+        detail::driver_lock lock { _io_mutex };
+        const auto capture = _active_capture();
+        if (capture && capture->captured_read(addr, value)) {
+            error = no_error_value;
+            return;
+        }
+        error = _cached_read(addr, value);
+    }
+    expected<value_type, error_type> try_read(addr_type addr) const noexcept
+    {
+        value_type value {};
+        error_type error { no_error_value };
+        read(addr, value, error);
+        if (error != no_error_value) {
+            return unexpected<error_type>(error);
+        }
+        return value;
+    }
+    expected<void, error_type> try_write(addr_type addr, value_type value) const noexcept
+    {
+        error_type error { no_error_value };
+        write(addr, value, error);
+        if (error != no_error_value) {
+            return unexpected<error_type>(error);
+        }
+        return {};
+    }
+    // Runs fn() without exceptions: errors raised by the driver calls inside
+    // come back as the error of the result.
+    template <typename Function>
+    auto try_invoke(Function&& fn) const noexcept
+    {
+        return detail::invoke_latched<error_type>(no_error_value, std::forward<Function>(fn));
     }
+    void write_block(addr_type addr, const value_type* values, std::size_t count) const
+    {
+        static const char error_msg[] { "chip reg block write error" };
+        if (error_raised()) {
+            return;
+        }
+        detail::driver_lock lock { _io_mutex };
+        if (const auto capture = _active_capture()) {
+            for (std::size_t i {}; i < count; ++i) {
+                capture->capture_write(addr_type(addr + i), values[i]);
+            }
+            return;
+        }
+        const error_type error = _cached_write_block(addr, values, count);
+        if (error != no_error_value)
+            detail::raise_error(error, error_msg);
+    }
+    void read_block(addr_type addr, value_type* values, std::size_t count) const
+    {
+        static const char error_msg[] { "chip reg block read error" };
+        if (error_raised()) {
+            return;
+        }
+        detail::driver_lock lock { _io_mutex };
+        const error_type error = _cached_read_block(addr, values, count);
+        if (error != no_error_value)
+            detail::raise_error(error, error_msg);
+        if (const auto capture = _active_capture()) {
+            for (std::size_t i {}; i < count; ++i) {
+                capture->captured_read(addr_type(addr + i), values[i]);
+            }
+        }
+    }
+    void write_block(addr_type addr, const value_type* values, std::size_t count, error_type& error) const noexcept
+    {
+        detail::driver_lock lock { _io_mutex };
+        if (_active_capture()) {
+            detail::error_latch_scope<error_type> latch {};
+            write_block(addr, values, count);
+            error = latch.get_error(no_error_value);
+            return;
+        }
+        error = _cached_write_block(addr, values, count);
+    }
+    void read_block(addr_type addr, value_type* values, std::size_t count, error_type& error) const noexcept
+    {
+        detail::driver_lock lock { _io_mutex };
+        error = _cached_read_block(addr, values, count);
+        const auto capture = _active_capture();
+        if (capture && error == no_error_value) {
+            for (std::size_t i {}; i < count; ++i) {
+                capture->captured_read(addr_type(addr + i), values[i]);
+            }
+        }
+    }
+    void write_batch(const reg_data_type* data, std::size_t count) const
+    {
+        if (error_raised()) {
+            return;
+        }
+        detail::driver_lock lock { _io_mutex };
+        if (const auto capture = _active_capture()) {
+            for (std::size_t i {}; i < count; ++i) {
+                capture->capture_write(data[i].addr, data[i].value);
+            }
+            return;
+        }
+        _write_batch(data, count);
+    }
+    void write_batch(const reg_data_type* data, std::size_t count, error_type& error) const noexcept
+    {
+        detail::error_latch_scope<error_type> latch {};
+        write_batch(data, count);
+        error = latch.get_error(no_error_value);
+    }
+    // The shadow cache is off by default. Once set up, registers below size
+    // are served from the cache after their first access: write_through keeps
+    // writing every value to the chip, write_back only marks it dirty until
+    // flush_cache(). Status and readback registers must be marked volatile so
+    // they always reach the chip, as must registers whose writes trigger an
+    // action. Write-back reorders writes, so flush before anything that
+    // depends on the chip state. Switching the mode drops pending dirty
+    // values, so flush them first.
+    void setup_cache(cache_mode mode, std::size_t size)
+    {
+        detail::driver_lock lock { _io_mutex };
+        _cache.setup(mode, size);
+    }
+    // The same for a chip declared with a register_table, which gives the
+    // size and the volatile registers.
+    template <typename RegisterTable>
+    void setup_cache(cache_mode mode)
+    {
+        detail::driver_lock lock { _io_mutex };
+        setup_cache(mode, RegisterTable::register_max_num);
+        RegisterTable::for_each_volatile([&](std::size_t addr) { set_volatile(addr_type(addr)); });
+    }
+    cache_mode get_cache_mode() const noexcept
+    {
+        detail::driver_lock lock { _io_mutex };
+        return _cache.get_mode();
+    }
+    // A dirty value of a register that becomes volatile is written to the
+    // chip first, the register is only marked once that succeeds.
+    void set_volatile(addr_type addr, std::size_t count = 1, bool is_volatile = true)
+    {
+        static const char error_msg[] { "chip reg cache flush error" };
+        detail::driver_lock lock { _io_mutex };
+        if (is_volatile) {
+            if (error_raised()) {
+                return;
+            }
+            for (std::size_t i {}; i < count; ++i) {
+                reg_data_type data { addr_type(addr + i), value_type {} };
+                if (!_cache.load_dirty(data.addr, data.value)) {
+                    continue;
+                }
+                const error_type error = _bus_write_batch(&data, 1);
+                if (error != no_error_value) {
+                    detail::raise_error(error, error_msg);
+                    return;
+                }
+            }
+        }
+        _cache.set_volatile(addr, count, is_volatile);
+    }
+    bool is_volatile(addr_type addr) const noexcept
+    {
+        detail::driver_lock lock { _io_mutex };
+        return std::size_t(addr) < _cache.size() && !_cache.is_cached(addr);
+    }
+    void invalidate_cache() const noexcept
+    {
+        detail::driver_lock lock { _io_mutex };
+        _cache.invalidate();
+    }
+    void flush_cache() const
+    {
+        static const char error_msg[] { "chip reg cache flush error" };
+        if (error_raised()) {
+            return;
+        }
+        detail::driver_lock lock { _io_mutex };
+        const error_type error = _flush_cache();
+        if (error != no_error_value)
+            detail::raise_error(error, error_msg);
+    }
+    void flush_cache(error_type& error) const noexcept
+    {
+        detail::driver_lock lock { _io_mutex };
+        error = _flush_cache();
+    }
+    // Applies to every bus access of the chip, including block and batch
+    // transfers, before an error is raised. A block is repeated as a whole.
+    void set_retry_policy(const retry_policy_type& policy)
+    {
+        _retry = policy;
+    }
+    const retry_policy_type& get_retry_policy() const noexcept { return _retry; }
     void setup_io(const reg_read_fn& reg_read, const reg_write_fn& reg_write, dev_addr_type dev_addr = {}) noexcept
     {
-        _reg_read = reg_read;
-        _reg_write = reg_write;
+        static_assert(std::is_same<io_type, _function_io>::value, "setup_io requires the dynamic_io policy");
+        _io.setup(reg_read, reg_write);
         _dev_addr = dev_addr;
     }
+    void setup_block_io(const reg_read_block_fn& reg_read_block, const reg_write_block_fn& reg_write_block) noexcept
+    {
+        static_assert(std::is_same<io_type, _function_io>::value, "setup_block_io requires the dynamic_io policy");
+        _io.setup_block(reg_read_block, reg_write_block);
+    }
+    void setup_batch_io(const reg_write_batch_fn& reg_write_batch) noexcept
+    {
+        static_assert(std::is_same<io_type, _function_io>::value, "setup_batch_io requires the dynamic_io policy");
+        _io.setup_batch(reg_write_batch);
+    }
     void set_dev_addr(dev_addr_type dev_addr) noexcept
     {
         _dev_addr = dev_addr;
     }
     dev_addr_type get_dev_addr() const noexcept { return _dev_addr; }
+#if defined(CHAPPI_STATS_ENABLE)
+    io_stats get_stats() const noexcept { return _stats.snapshot(); }
+    void reset_stats() const noexcept { _stats.reset(); }
+#endif
+#if defined(CHAPPI_TRACE_ENABLE)
+    // Identifies the chip in trace records.
+    uint32_t get_trace_id() const noexcept { return _trace_id; }
+#endif
+    io_type& get_io() noexcept { return _io; }
+    const io_type& get_io() const noexcept { return _io; }
 
 private:
+    template <typename ChipType, std::size_t Capacity>
+    friend class transaction;
+    using _capture_type = detail::write_capture<addr_type, value_type>;
+    // A transaction only captures the accesses of the thread that opened it.
+    _capture_type* _active_capture() const noexcept
+    {
+#if defined(CHAPPI_THREAD_SAFE)
+        if (_capture_thread != std::this_thread::get_id()) {
+            return nullptr;
+        }
+#endif
+        return _capture;
+    }
+    bool _attach_capture(_capture_type* capture) const noexcept
+    {
+        detail::driver_lock lock { _io_mutex };
+        if (_capture) {
+            return false;
+        }
+        _capture = capture;
+#if defined(CHAPPI_THREAD_SAFE)
+        _capture_thread = std::this_thread::get_id();
+#endif
+        return true;
+    }
+    bool _is_capture(const _capture_type* capture) const noexcept
+    {
+        detail::driver_lock lock { _io_mutex };
+        return _capture == capture;
+    }
+    void _detach_capture(const _capture_type* capture) const noexcept
+    {
+        detail::driver_lock lock { _io_mutex };
+        if (_capture == capture) {
+            _capture = nullptr;
+        }
+    }
+    void _write_batch(const reg_data_type* data, std::size_t count) const
+    {
+        static const char error_msg[] { "chip reg batch write error" };
+        detail::driver_lock lock { _io_mutex };
+        error_type error { no_error_value };
+        if (_cache.get_mode() != cache_mode::write_back) {
+            error = _bus_write_batch(data, count);
+        } else {
+            // Registers held back by the cache stay there, the rest go out in order.
+            const std::size_t chunk_max { 64 };
+            reg_data_type chunk[chunk_max];
+            std::size_t chunk_size {};
+            for (std::size_t i {}; i < count && error == no_error_value; ++i) {
+                if (_cache.holds_back(data[i].addr)) {
+                    _cache.store(data[i].addr, data[i].value, true);
+                    continue;
+                }
+                chunk[chunk_size++] = data[i];
+                if (chunk_size == chunk_max) {
+                    error = _bus_write_batch(chunk, chunk_size);
+                    chunk_size = 0;
+                }
+            }
+            if (chunk_size != 0 && error == no_error_value) {
+                error = _bus_write_batch(chunk, chunk_size);
+            }
+        }
+        if (error != no_error_value)
+            detail::raise_error(error, error_msg);
+    }
+    error_type _cached_write(addr_type addr, value_type value) const
+    {
+        if (_cache.holds_back(addr)) {
+            _cache.store(addr, value, true);
+            return no_error_value;
+        }
+        detail::io_timing timing {};
+        const error_type error = _call_io(false, 1, timing, [&] { return _io.write(_dev_addr, addr, value); });
+#if CHAPPI_LOG_LEVEL >= CHAPPI_LOG_LEVEL_IO
+        if (log.is_enabled()) {
+            log << '[' << _name << ']' << " <W> DEV:" << +_dev_addr << " | REG:" << +addr << " | VAL:" << +value << '\n';
+        }
+#endif
+#if defined(CHAPPI_TRACE_ENABLE)
+        _trace(trace_op::write, error, addr, value, timing, 0, 1);
+#endif
+        if (error == no_error_value) {
+            _cache.store_written(addr, value);
+        }
+        return error;
+    }
+    error_type _cached_read(addr_type addr, value_type& value) const
+    {
+        if (_cache.load(addr, value)) {
+            return no_error_value;
+        }
+        detail::io_timing timing {};
+        const error_type error = _call_io(true, 1, timing, [&] { return _io.read(_dev_addr, addr, value); });
+#if CHAPPI_LOG_LEVEL >= CHAPPI_LOG_LEVEL_IO
+        if (log.is_enabled()) {
+            log << '[' << _name << ']' << " <R> DEV:" << +_dev_addr << " | REG:" << +addr << " | VAL:" << +value << '\n';
+        }
+#endif
+#if defined(CHAPPI_TRACE_ENABLE)
+        _trace(trace_op::read, error, addr, value, timing, 0, 1);
+#endif
+        if (error == no_error_value && !_cache.load_dirty(addr, value)) {
+            _cache.store(addr, value);
+        }
+        return error;
+    }
+    error_type _cached_write_block(addr_type addr, const value_type* values, std::size_t count) const
+    {
+        bool held_back { count != 0 };
+        for (std::size_t i {}; i < count && held_back; ++i) {
+            held_back = _cache.holds_back(addr_type(addr + i));
+        }
+        if (held_back) {
+            for (std::size_t i {}; i < count; ++i) {
+                _cache.store(addr_type(addr + i), values[i], true);
+            }
+            return no_error_value;
+        }
+        detail::io_timing timing {};
+        const error_type error = _call_io(false, count, timing, [&] { return detail::io_write_block<error_type, NoerrorValue>(_io, _dev_addr, addr, values, count, 0); });
+#if CHAPPI_LOG_LEVEL >= CHAPPI_LOG_LEVEL_IO
+        if (log.is_enabled()) {
+            for (std::size_t i {}; i < count; ++i) {
+                log << '[' << _name << ']' << " <W> DEV:" << +_dev_addr << " | REG:" << +addr_type(addr + i) << " | VAL:" << +values[i] << '\n';
+            }
+        }
+#endif
+#if defined(CHAPPI_TRACE_ENABLE)
+        for (std::size_t i {}; i < count; ++i) {
+            _trace(trace_op::write, error, addr_type(addr + i), values[i], timing, i, count);
+        }
+#endif
+        if (error == no_error_value) {
+            for (std::size_t i {}; i < count; ++i) {
+                _cache.store_written(addr_type(addr + i), values[i]);
+            }
+        }
+        return error;
+    }
+    error_type _cached_read_block(addr_type addr, value_type* values, std::size_t count) const
+    {
+        bool cached { count != 0 };
+        for (std::size_t i {}; i < count && cached; ++i) {
+            cached = _cache.load(addr_type(addr + i), values[i]);
+        }
+        if (cached) {
+            return no_error_value;
+        }
+        detail::io_timing timing {};
+        const error_type error = _call_io(true, count, timing, [&] { return detail::io_read_block<error_type, NoerrorValue>(_io, _dev_addr, addr, values, count, 0); });
+#if CHAPPI_LOG_LEVEL >= CHAPPI_LOG_LEVEL_IO
+        if (log.is_enabled()) {
+            for (std::size_t i {}; i < count; ++i) {
+                log << '[' << _name << ']' << " <R> DEV:" << +_dev_addr << " | REG:" << +addr_type(addr + i) << " | VAL:" << +values[i] << '\n';
+            }
+        }
+#endif
+#if defined(CHAPPI_TRACE_ENABLE)
+        for (std::size_t i {}; i < count; ++i) {
+            _trace(trace_op::read, error, addr_type(addr + i), values[i], timing, i, count);
+        }
+#endif
+        if (error == no_error_value) {
+            // Dirty values have not reached the chip yet and win over what was read.
+            for (std::size_t i {}; i < count; ++i) {
+                if (!_cache.load_dirty(addr_type(addr + i), values[i])) {
+                    _cache.store(addr_type(addr + i), values[i]);
+                }
+            }
+        }
+        return error;
+    }
+    error_type _bus_write_batch(const reg_data_type* data, std::size_t count) const
+    {
+        detail::io_timing timing {};
+        const error_type error = _call_io(false, count, timing, [&] { return detail::io_write_batch<error_type, NoerrorValue>(_io, _dev_addr, data, count, 0); });
+#if CHAPPI_LOG_LEVEL >= CHAPPI_LOG_LEVEL_IO
+        if (log.is_enabled()) {
+            for (std::size_t i {}; i < count; ++i) {
+                log << '[' << _name << ']' << " <W> DEV:" << +_dev_addr << " | REG:" << +data[i].addr << " | VAL:" << +data[i].value << '\n';
+            }
+        }
+#endif
+#if defined(CHAPPI_TRACE_ENABLE)
+        for (std::size_t i {}; i < count; ++i) {
+            _trace(trace_op::write, error, data[i].addr, data[i].value, timing, i, count);
+        }
+#endif
+        if (error == no_error_value) {
+            for (std::size_t i {}; i < count; ++i) {
+                _cache.store_written(data[i].addr, data[i].value);
+            }
+        }
+        return error;
+    }
+    // Every call into the bus callbacks goes through here, timing is filled
+    // in when statistics or tracing need it.
+    template <typename Function>
+    error_type _call_io(bool read, std::size_t regs, detail::io_timing& timing, Function&& fn) const
+    {
+#if defined(CHAPPI_STATS_ENABLE) || defined(CHAPPI_TRACE_ENABLE)
+        timing.start_ns = detail::trace_clock_ns();
+        const error_type error = _call_with_retry(fn);
+        timing.duration_ns = detail::trace_clock_ns() - timing.start_ns;
+#if defined(CHAPPI_STATS_ENABLE)
+        _stats.record(read, regs, regs * sizeof(value_type), error != no_error_value, std::chrono::nanoseconds(timing.duration_ns));
+#else
+        static_cast<void>(read);
+        static_cast<void>(regs);
+#endif
+        return error;
+#else
+        static_cast<void>(read);
+        static_cast<void>(regs);
+        static_cast<void>(timing);
+        return _call_with_retry(fn);
+#endif
+    }
+    template <typename Function>
+    error_type _call_with_retry(Function& fn) const
+    {
+        error_type error = fn();
+        if (error == no_error_value || _retry.attempts < 2) {
+            return error;
+        }
+        auto backoff = _retry.backoff;
+        for (unsigned attempt { 1 }; attempt < _retry.attempts; ++attempt) {
+            if (_retry.is_retryable && !_retry.is_retryable(error)) {
+                break;
+            }
+#if CHAPPI_LOG_LEVEL >= CHAPPI_LOG_LEVEL_IO
+            if (log.is_enabled()) {
+                log << '[' << _name << ']' << " retry " << attempt << '\n';
+            }
+#endif
+            if (backoff.count() > 0) {
+                // Every bus access runs under _io_mutex. The backoff gives
+                // up this call's hold on it, so other threads reach the chip
+                // meanwhile; the stores after the transfer keep what they
+                // wrote. A caller that locked the chip itself, or a driver
+                // lock around the call, still holds the instance.
+                _io_mutex.unlock();
+                std::this_thread::sleep_for(backoff);
+                _io_mutex.lock();
+                backoff = std::min(backoff * _retry.backoff_factor, _retry.backoff_max);
+            }
+#if defined(CHAPPI_STATS_ENABLE)
+            _stats.record_retry();
+#endif
+            error = fn();
+            if (error == no_error_value) {
+                break;
+            }
+        }
+        return error;
+    }
+#if defined(CHAPPI_TRACE_ENABLE)
+    // A block transfer is traced per register, the transfer time is spread
+    // evenly over its registers.
+    void _trace(trace_op op, error_type error, addr_type addr, value_type value, const detail::io_timing& timing,
+        std::size_t index, std::size_t count) const noexcept
+    {
+        const auto duration = timing.duration_ns / count;
+        detail::trace(_trace_id, op, error != no_error_value, uint32_t(_dev_addr), uint32_t(addr), uint32_t(value),
+            timing.start_ns + duration * index, duration);
+    }
+#endif
+    error_type _flush_cache() const
+    {
+        const std::size_t chunk_max { 64 };
+        reg_data_type chunk[chunk_max];
+        error_type error { no_error_value };
+        std::size_t next {};
+        while (next < _cache.size() && error == no_error_value) {
+            std::size_t chunk_size { chunk_max };
+            next = _cache.collect_dirty(next, chunk, chunk_size);
+            if (chunk_size != 0) {
+                error = _bus_write_batch(chunk, chunk_size);
+            }
+        }
+        return error;
+    }
+
+    char _name[32] {};
     dev_addr_type _dev_addr {};
-    reg_read_fn _reg_read {};
-    reg_write_fn _reg_write {};
+    io_type _io {};
+    // Guards the cache and the transaction state.
+    mutable detail::driver_mutex _io_mutex {};
+    mutable _capture_type* _capture {};
+#if defined(CHAPPI_THREAD_SAFE)
+    mutable std::thread::id _capture_thread {};
+#endif
+    mutable detail::register_cache<addr_type, value_type> _cache {};
+    retry_policy_type _retry {};
+#if defined(CHAPPI_TRACE_ENABLE)
+    const uint32_t _trace_id { detail::next_trace_id() };
+#endif
+#if defined(CHAPPI_STATS_ENABLE)
+    mutable detail::io_stats_counter _stats {};
+#endif
 };
 
 } // namespace chappi
@@ -0,0 +1,279 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "chappi_base.h"
+
+namespace chappi {
+
+// Serializes register access of all chips attached to one physical bus.
+// Requests are queued by priority, higher first and in arrival order within
+// a priority, and run by whichever caller holds the bus, so no extra thread
+// is needed. Writes to one device that follow each other in the queue are
+// merged into a single batch transfer.
+template <typename ErrorType = int, ErrorType NoerrorValue = 0,
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t>
+class bus {
+    using _io_type = detail::function_io<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>;
+
+public:
+    using error_type = ErrorType;
+    using dev_addr_type = DevAddrType;
+    using addr_type = AddrType;
+    using value_type = ValueType;
+    using reg_read_fn = typename _io_type::reg_read_fn;
+    using reg_write_fn = typename _io_type::reg_write_fn;
+    using reg_read_block_fn = typename _io_type::reg_read_block_fn;
+    using reg_write_block_fn = typename _io_type::reg_write_block_fn;
+    using reg_write_batch_fn = typename _io_type::reg_write_batch_fn;
+    using reg_data_type = reg_data<addr_type, value_type>;
+
+    bus(const reg_read_fn& reg_read, const reg_write_fn& reg_write)
+        : _io { reg_read, reg_write }
+    {
+    }
+    bus(const bus&) = delete;
+    bus& operator=(const bus&) = delete;
+    // The bus callbacks have to be set up before the bus is used.
+    void setup_block_io(const reg_read_block_fn& reg_read_block, const reg_write_block_fn& reg_write_block)
+    {
+        _io.setup_block(reg_read_block, reg_write_block);
+    }
+    void setup_batch_io(const reg_write_batch_fn& reg_write_batch)
+    {
+        _io.setup_batch(reg_write_batch);
+    }
+    // Routes the chip I/O through the bus. All requests of the chip are
+    // queued with the given priority.
+    template <typename ChipType>
+    void attach(ChipType& chip, dev_addr_type dev_addr, int priority = 0)
+    {
+        static_assert(std::is_same<typename ChipType::error_type, error_type>::value
+                && std::is_same<typename ChipType::dev_addr_type, dev_addr_type>::value
+                && std::is_same<typename ChipType::addr_type, addr_type>::value
+                && std::is_same<typename ChipType::value_type, value_type>::value,
+            "chip and bus register types differ");
+        chip.setup_io(
+            [this, priority](dev_addr_type dev_addr, addr_type addr, value_type& value) {
+                return read(dev_addr, addr, value, priority);
+            },
+            [this, priority](dev_addr_type dev_addr, addr_type addr, value_type value) {
+                return write(dev_addr, addr, value, priority);
+            },
+            dev_addr);
+        chip.setup_block_io(
+            [this, priority](dev_addr_type dev_addr, addr_type addr, value_type* values, std::size_t count) {
+                return read_block(dev_addr, addr, values, count, priority);
+            },
+            [this, priority](dev_addr_type dev_addr, addr_type addr, const value_type* values, std::size_t count) {
+                return write_block(dev_addr, addr, values, count, priority);
+            });
+        chip.setup_batch_io(
+            [this, priority](dev_addr_type dev_addr, const reg_data_type* data, std::size_t count) {
+                return write_batch(dev_addr, data, count, priority);
+            });
+    }
+    error_type read(dev_addr_type dev_addr, addr_type addr, value_type& value, int priority = 0)
+    {
+        _request request { _kind::read, priority, dev_addr, addr };
+        request.values = &value;
+        request.count = 1;
+        return _submit(request);
+    }
+    error_type write(dev_addr_type dev_addr, addr_type addr, value_type value, int priority = 0)
+    {
+        _request request { _kind::write, priority, dev_addr, addr };
+        request.value = value;
+        request.write_values = &request.value;
+        request.count = 1;
+        return _submit(request);
+    }
+    error_type read_block(dev_addr_type dev_addr, addr_type addr, value_type* values, std::size_t count, int priority = 0)
+    {
+        _request request { _kind::read_block, priority, dev_addr, addr };
+        request.values = values;
+        request.count = count;
+        return _submit(request);
+    }
+    error_type write_block(dev_addr_type dev_addr, addr_type addr, const value_type* values, std::size_t count, int priority = 0)
+    {
+        _request request { _kind::write_block, priority, dev_addr, addr };
+        request.write_values = values;
+        request.count = count;
+        return _submit(request);
+    }
+    error_type write_batch(dev_addr_type dev_addr, const reg_data_type* data, std::size_t count, int priority = 0)
+    {
+        _request request { _kind::write_batch, priority, dev_addr };
+        request.data = data;
+        request.count = count;
+        return _submit(request);
+    }
+    // Number of transfers handed to the bus callbacks, merged ones count once.
+    std::size_t get_transfers() const
+    {
+        std::lock_guard<std::mutex> lock { _mutex };
+        return _transfers;
+    }
+
+private:
+    enum class _kind {
+        read,
+        write,
+        read_block,
+        write_block,
+        write_batch
+    };
+    struct _request {
+        _kind kind;
+        int priority;
+        dev_addr_type dev_addr;
+        addr_type addr {};
+        value_type* values {};
+        const value_type* write_values {};
+        const reg_data_type* data {};
+        std::size_t count {};
+        value_type value {};
+        error_type error { NoerrorValue };
+        std::exception_ptr exception {};
+        bool done {};
+        _request* next {};
+        bool is_write() const noexcept { return kind == _kind::write || kind == _kind::write_block || kind == _kind::write_batch; }
+    };
+
+    error_type _submit(_request& request)
+    {
+        std::unique_lock<std::mutex> lock { _mutex };
+        _enqueue(request);
+        while (!request.done) {
+            if (_combining) {
+                _cv.wait(lock);
+                continue;
+            }
+            _combining = true;
+            while (!request.done) {
+                _run_front(lock);
+            }
+            _combining = false;
+            _cv.notify_all();
+        }
+        if (request.exception) {
+            std::rethrow_exception(request.exception);
+        }
+        return request.error;
+    }
+    void _enqueue(_request& request) noexcept
+    {
+        auto pos = &_queue;
+        while (*pos && (*pos)->priority >= request.priority) {
+            pos = &(*pos)->next;
+        }
+        request.next = *pos;
+        *pos = &request;
+    }
+    void _run_front(std::unique_lock<std::mutex>& lock)
+    {
+        auto first = _queue;
+        auto last = first;
+        if (first->is_write()) {
+            while (last->next && last->next->is_write() && last->next->dev_addr == first->dev_addr) {
+                last = last->next;
+            }
+        }
+        _queue = last->next;
+        last->next = nullptr;
+        ++_transfers;
+        lock.unlock();
+        error_type error { NoerrorValue };
+        std::exception_ptr exception {};
+#if CHAPPI_EXCEPTIONS
+        try {
+            error = (first == last) ? _transfer(*first) : _transfer_merged(first);
+        } catch (...) {
+            exception = std::current_exception();
+        }
+#else
+        error = (first == last) ? _transfer(*first) : _transfer_merged(first);
+#endif
+        lock.lock();
+        for (auto request = first; request; request = request->next) {
+            request->error = error;
+            request->exception = exception;
+            request->done = true;
+        }
+        _cv.notify_all();
+    }
+    error_type _transfer(const _request& request) const
+    {
+        switch (request.kind) {
+        case _kind::read:
+            return _io.read(request.dev_addr, request.addr, *request.values);
+        case _kind::write:
+            return _io.write(request.dev_addr, request.addr, request.value);
+        case _kind::read_block:
+            return _io.read_block(request.dev_addr, request.addr, request.values, request.count);
+        case _kind::write_block:
+            return _io.write_block(request.dev_addr, request.addr, request.write_values, request.count);
+        case _kind::write_batch:
+            return _io.write_batch(request.dev_addr, request.data, request.count);
+        }
+        return NoerrorValue;
+    }
+    // Only the thread holding the bus gets here, so the buffer needs no lock.
+    error_type _transfer_merged(const _request* request)
+    {
+        const auto dev_addr = request->dev_addr;
+        _merged.clear();
+        for (; request; request = request->next) {
+            if (request->kind == _kind::write_batch) {
+                _merged.insert(_merged.end(), request->data, request->data + request->count);
+                continue;
+            }
+            for (std::size_t i {}; i < request->count; ++i) {
+                _merged.push_back(reg_data_type { addr_type(request->addr + i), request->write_values[i] });
+            }
+        }
+        return _io.write_batch(dev_addr, _merged.data(), _merged.size());
+    }
+
+    _io_type _io;
+    mutable std::mutex _mutex {};
+    std::condition_variable _cv {};
+    _request* _queue {};
+    bool _combining {};
+    std::size_t _transfers {};
+    std::vector<reg_data_type> _merged {};
+};
+
+} // namespace chappi
@@ -0,0 +1,287 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "chappi_except.h"
+#include "chappi_register.h"
+
+namespace chappi {
+
+namespace detail {
+    inline bool dump_is_blank(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+    inline const char* dump_skip_blanks(const char* begin, const char* end) noexcept
+    {
+        while (begin != end && dump_is_blank(*begin)) {
+            ++begin;
+        }
+        return begin;
+    }
+    // Reads a number in base, hex with an optional 0x prefix. Returns the
+    // position after its digits, nullptr when there are none or it overflows.
+    inline const char* dump_parse_number(const char* begin, const char* end, unsigned base, uint32_t& value) noexcept
+    {
+        if (base == 16 && end - begin > 2 && begin[0] == '0' && (begin[1] == 'x' || begin[1] == 'X')) {
+            begin += 2;
+        }
+        uint64_t number {};
+        const auto start = begin;
+        for (; begin != end; ++begin) {
+            unsigned digit {};
+            if (*begin >= '0' && *begin <= '9') {
+                digit = unsigned(*begin - '0');
+            } else if (base == 16 && *begin >= 'a' && *begin <= 'f') {
+                digit = unsigned(*begin - 'a' + 10);
+            } else if (base == 16 && *begin >= 'A' && *begin <= 'F') {
+                digit = unsigned(*begin - 'A' + 10);
+            } else {
+                break;
+            }
+            if (digit >= base) {
+                break;
+            }
+            number = number * base + digit;
+            if (number > std::numeric_limits<uint32_t>::max()) {
+                return nullptr;
+            }
+        }
+        if (begin == start) {
+            return nullptr;
+        }
+        value = uint32_t(number);
+        return begin;
+    }
+} // namespace detail
+
+// TI TICS Pro register export, one "R112\t0x700000" line per register: the
+// register number in decimal and the 24-bit SPI word with the address in
+// bits 22:16 and the value in bits 15:0, as for LMX2594.
+struct tics_pro_format {
+    static bool parse(const char* begin, const char* end, std::size_t& addr, uint32_t& value) noexcept
+    {
+        if (begin == end || *begin != 'R') {
+            return false;
+        }
+        uint32_t number {};
+        auto pos = detail::dump_parse_number(begin + 1, end, 10, number);
+        if (!pos || pos == end || !detail::dump_is_blank(*pos)) {
+            return false;
+        }
+        uint32_t word {};
+        pos = detail::dump_parse_number(detail::dump_skip_blanks(pos, end), end, 16, word);
+        if (!pos || pos != end || ((word >> 16) & 0x7F) != number) {
+            return false;
+        }
+        addr = number;
+        value = word & 0xFFFF;
+        return true;
+    }
+};
+
+// LTC6953 register text, the address and the value in hex on each line:
+// "h0B 0x12", "0x0B, 0x12" or "0B=12".
+struct ltc6953_text_format {
+    static bool parse(const char* begin, const char* end, std::size_t& addr, uint32_t& value) noexcept
+    {
+        if (begin != end && (*begin == 'h' || *begin == 'H')) {
+            ++begin;
+        }
+        uint32_t number {};
+        auto pos = detail::dump_parse_number(begin, end, 16, number);
+        if (!pos) {
+            return false;
+        }
+        pos = detail::dump_skip_blanks(pos, end);
+        if (pos != end && (*pos == ',' || *pos == ':' || *pos == '=')) {
+            pos = detail::dump_skip_blanks(pos + 1, end);
+        } else if (!detail::dump_is_blank(pos[-1])) {
+            return false;
+        }
+        pos = detail::dump_parse_number(pos, end, 16, value);
+        if (!pos || pos != end) {
+            return false;
+        }
+        addr = number;
+        return true;
+    }
+};
+
+// Splits a dump fed in chunks of any size into lines for the handler:
+// on_profile(name, length) for a "[name]" line, which starts a profile of
+// a multi-profile file, and on_register(addr, value) for a register line
+// of Format, which returns false when the register does not fit. Blank
+// lines and lines starting with '#', ';' or "//" are skipped, anything else
+// is an error naming the line. Only the current line is buffered.
+template <typename Format, typename Handler>
+class register_dump_parser {
+public:
+    static constexpr std::size_t line_max { 256 };
+
+    explicit register_dump_parser(Handler& handler) noexcept
+        : _handler { handler }
+    {
+    }
+    void feed(const char* data, std::size_t size)
+    {
+        for (std::size_t pos {}; pos < size; ++pos) {
+            if (data[pos] == '\n') {
+                _parse_line();
+            } else if (_length < line_max) {
+                _line[_length++] = data[pos];
+            } else {
+                _overflow = true;
+            }
+        }
+    }
+    // Parses a last line without a newline.
+    void finish()
+    {
+        if (_length != 0 || _overflow) {
+            _parse_line();
+        }
+    }
+
+private:
+    void _parse_line()
+    {
+        ++_line_num;
+        const auto overflow = _overflow;
+        const auto begin = detail::dump_skip_blanks(_line.data(), _line.data() + _length);
+        auto end = _line.data() + _length;
+        _length = 0;
+        _overflow = false;
+        if (overflow) {
+            _error("line too long");
+            return;
+        }
+        while (end != begin && detail::dump_is_blank(end[-1])) {
+            --end;
+        }
+        if (begin == end || *begin == '#' || *begin == ';' || (end - begin > 1 && begin[0] == '/' && begin[1] == '/')) {
+            return;
+        }
+        if (*begin == '[') {
+            if (end[-1] != ']') {
+                _error("unterminated profile name");
+                return;
+            }
+            _handler.on_profile(begin + 1, std::size_t(end - begin - 2));
+            return;
+        }
+        std::size_t addr {};
+        uint32_t value {};
+        if (!Format::parse(begin, end, addr, value)) {
+            _error("not a register line");
+            return;
+        }
+        if (!_handler.on_register(addr, value)) {
+            _error("register out of range");
+        }
+    }
+    void _error(const char* message) const
+    {
+        detail::throw_exception(std::runtime_error("chappi::register_dump_parser: line " + std::to_string(_line_num) + ": " + message));
+    }
+
+    Handler& _handler;
+    std::array<char, line_max> _line {};
+    std::size_t _length {};
+    std::size_t _line_num {};
+    bool _overflow {};
+};
+
+// Collects parsed registers into DumpType profiles, a register_dump of the
+// chip, and passes each complete one to fn, so one profile is held at a
+// time. Registers before the first "[name]" line form a profile without a
+// name.
+template <typename DumpType, typename Function>
+class register_dump_reader {
+    using register_type = std::remove_reference_t<decltype(std::declval<DumpType>().values.array[0])>;
+    static constexpr std::size_t _register_max_num { std::extent<decltype(DumpType::values.array)>::value };
+
+public:
+    explicit register_dump_reader(Function fn)
+        : _fn { fn }
+    {
+    }
+    void on_profile(const char* name, std::size_t length)
+    {
+        finish();
+        _dump.profile.assign(name, length);
+        _started = true;
+    }
+    bool on_register(std::size_t addr, uint32_t value)
+    {
+        if (addr >= _register_max_num || value > std::numeric_limits<register_type>::max()) {
+            return false;
+        }
+        _dump.values.array[addr] = register_type(value);
+        _dump.registers.set_changed(addr);
+        _started = true;
+        return true;
+    }
+    void finish()
+    {
+        if (_started) {
+            _fn(static_cast<const DumpType&>(_dump));
+            _dump = {};
+            _started = false;
+        }
+    }
+
+private:
+    Function _fn;
+    DumpType _dump {};
+    bool _started {};
+};
+
+// Reads every profile of a dump in Format from stream and calls
+// fn(const DumpType&) for each, in file order.
+template <typename Format, typename DumpType, typename Function>
+void read_register_dumps(std::istream& stream, Function&& fn)
+{
+    register_dump_reader<DumpType, Function&> reader { fn };
+    register_dump_parser<Format, register_dump_reader<DumpType, Function&>> parser { reader };
+    std::array<char, 4096> buffer;
+    while (stream) {
+        stream.read(buffer.data(), std::streamsize(buffer.size()));
+        parser.feed(buffer.data(), std::size_t(stream.gcount()));
+    }
+    parser.finish();
+    reader.finish();
+}
+
+} // namespace chappi
@@ -25,7 +25,23 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
+#include <cstdio>
+#include <cstdlib>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Exceptions are used when the compiler has them enabled. Without them the
+// throwing API prints the error and aborts, so use the error_type& overloads,
+// try_invoke() or try_read()/try_write() instead.
+#if !defined(CHAPPI_EXCEPTIONS)
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define CHAPPI_EXCEPTIONS 1
+#else
+#define CHAPPI_EXCEPTIONS 0
+#endif
+#endif
 
 namespace chappi {
 
@@ -48,4 +64,230 @@ public:
     virtual ~runtime_error() noexcept = default;
 };
 
+// Error code reported through the error_type& overloads and expected
+// results when a driver fails for a reason other than a bus error, such as
+// a rejected argument. Specialize it if -1 is not suitable for an error type.
+template <typename ErrorType>
+struct error_traits {
+    static constexpr ErrorType driver_error() noexcept { return static_cast<ErrorType>(-1); }
+};
+
+namespace detail {
+    template <typename Exception>
+    [[noreturn]] void throw_exception(Exception&& exception)
+    {
+#if CHAPPI_EXCEPTIONS
+        throw std::forward<Exception>(exception);
+#else
+        std::fputs(exception.what(), stderr);
+        std::fputc('\n', stderr);
+        std::abort();
+#endif
+    }
+
+    // While a non-throwing call runs, errors are latched here instead of
+    // being thrown. The first error sticks and the chips skip all further
+    // bus accesses on this thread until the call returns.
+    template <typename ErrorType>
+    struct error_latch {
+        ErrorType error;
+        bool raised;
+    };
+    template <typename ErrorType>
+    error_latch<ErrorType>*& current_error_latch() noexcept
+    {
+        static thread_local error_latch<ErrorType>* latch {};
+        return latch;
+    }
+    template <typename ErrorType>
+    class error_latch_scope {
+    public:
+        error_latch_scope() noexcept
+            : _previous { current_error_latch<ErrorType>() }
+        {
+            current_error_latch<ErrorType>() = &_latch;
+        }
+        error_latch_scope(const error_latch_scope&) = delete;
+        error_latch_scope& operator=(const error_latch_scope&) = delete;
+        ~error_latch_scope() noexcept { current_error_latch<ErrorType>() = _previous; }
+        bool is_raised() const noexcept { return _latch.raised; }
+        ErrorType get_error(ErrorType no_error) const noexcept { return _latch.raised ? _latch.error : no_error; }
+
+    private:
+        error_latch<ErrorType> _latch {};
+        error_latch<ErrorType>* const _previous;
+    };
+    // Stores the latched error, or no_error, into error when it goes out of
+    // scope.
+    template <typename ErrorType>
+    class error_latch_guard {
+    public:
+        error_latch_guard(ErrorType& error, ErrorType no_error) noexcept
+            : _error { error }
+            , _no_error { no_error }
+        {
+        }
+        error_latch_guard(const error_latch_guard&) = delete;
+        error_latch_guard& operator=(const error_latch_guard&) = delete;
+        ~error_latch_guard() noexcept { _error = _scope.get_error(_no_error); }
+
+    private:
+        error_latch_scope<ErrorType> _scope {};
+        ErrorType& _error;
+        const ErrorType _no_error;
+    };
+    template <typename ErrorType>
+    bool is_error_raised() noexcept
+    {
+        const auto latch = current_error_latch<ErrorType>();
+        return latch && latch->raised;
+    }
+
+    template <typename ErrorType>
+    ErrorType error_code(const runtime_error<ErrorType>& exception) noexcept
+    {
+        return exception.get_error();
+    }
+    template <typename ErrorType, typename Exception>
+    ErrorType error_code(const Exception&) noexcept
+    {
+        return error_traits<ErrorType>::driver_error();
+    }
+    // Latch the error when a non-throwing call is running and throw it
+    // otherwise. Bus errors take the first form, which does not build an
+    // exception unless it is thrown.
+    template <typename ErrorType>
+    void raise_error(ErrorType error, const char* message)
+    {
+        if (const auto latch = current_error_latch<ErrorType>()) {
+            if (!latch->raised) {
+                latch->error = error;
+                latch->raised = true;
+            }
+            return;
+        }
+        throw_exception(runtime_error<ErrorType>(error, message));
+    }
+    template <typename ErrorType, typename Exception>
+    void raise_error(Exception&& exception)
+    {
+        if (const auto latch = current_error_latch<ErrorType>()) {
+            if (!latch->raised) {
+                latch->error = error_code<ErrorType>(exception);
+                latch->raised = true;
+            }
+            return;
+        }
+        throw_exception(std::forward<Exception>(exception));
+    }
+} // namespace detail
+
+template <typename ErrorType>
+class unexpected {
+public:
+    explicit unexpected(ErrorType error) noexcept
+        : _error { error }
+    {
+    }
+    ErrorType error() const noexcept { return _error; }
+
+private:
+    ErrorType _error;
+};
+
+// Result of a non-throwing call: the value or the error code.
+template <typename ValueType, typename ErrorType>
+class expected {
+public:
+    using value_type = ValueType;
+    using error_type = ErrorType;
+
+    expected(ValueType value)
+        : _value { std::move(value) }
+        , _error {}
+        , _has_value { true }
+    {
+    }
+    expected(unexpected<ErrorType> error)
+        : _value {}
+        , _error { error.error() }
+        , _has_value { false }
+    {
+    }
+    bool has_value() const noexcept { return _has_value; }
+    explicit operator bool() const noexcept { return _has_value; }
+    const ValueType& value() const
+    {
+        if (!_has_value) {
+            detail::throw_exception(runtime_error<ErrorType>(_error, "chappi::expected: no value"));
+        }
+        return _value;
+    }
+    ValueType value_or(ValueType value) const { return _has_value ? _value : std::move(value); }
+    ErrorType error() const noexcept { return _error; }
+    const ValueType& operator*() const noexcept { return _value; }
+    const ValueType* operator->() const noexcept { return &_value; }
+
+private:
+    ValueType _value;
+    ErrorType _error;
+    bool _has_value;
+};
+
+template <typename ErrorType>
+class expected<void, ErrorType> {
+public:
+    using value_type = void;
+    using error_type = ErrorType;
+
+    expected() noexcept
+        : _error {}
+        , _has_value { true }
+    {
+    }
+    expected(unexpected<ErrorType> error) noexcept
+        : _error { error.error() }
+        , _has_value { false }
+    {
+    }
+    bool has_value() const noexcept { return _has_value; }
+    explicit operator bool() const noexcept { return _has_value; }
+    void value() const
+    {
+        if (!_has_value) {
+            detail::throw_exception(runtime_error<ErrorType>(_error, "chappi::expected: no value"));
+        }
+    }
+    ErrorType error() const noexcept { return _error; }
+
+private:
+    ErrorType _error;
+    bool _has_value;
+};
+
+namespace detail {
+    template <typename ErrorType, typename Function>
+    auto invoke_latched(ErrorType no_error, Function&& fn)
+        -> std::enable_if_t<!std::is_void<decltype(fn())>::value, expected<decltype(fn()), ErrorType>>
+    {
+        error_latch_scope<ErrorType> latch {};
+        auto value = fn();
+        if (latch.is_raised()) {
+            return unexpected<ErrorType>(latch.get_error(no_error));
+        }
+        return value;
+    }
+    template <typename ErrorType, typename Function>
+    auto invoke_latched(ErrorType no_error, Function&& fn)
+        -> std::enable_if_t<std::is_void<decltype(fn())>::value, expected<void, ErrorType>>
+    {
+        error_latch_scope<ErrorType> latch {};
+        fn();
+        if (latch.is_raised()) {
+            return unexpected<ErrorType>(latch.get_error(no_error));
+        }
+        return {};
+    }
+} // namespace detail
+
 } // namespace chappi
@@ -92,8 +92,8 @@ namespace detail {
 } // namespace detail
 
 template <typename ErrorType = int, ErrorType NoerrorValue = 0,
-    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t>
-class hmc987 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t, typename IoPolicy = dynamic_io>
+class hmc987 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy> {
     static constexpr auto _chip_name = "HMC987";
     detail::hmc987_counter _counter;
 
@@ -104,8 +104,9 @@ public:
     {
     }
     hmc987(std::streambuf* buf_ptr = {}, reg_read_fn reg_read = {}, reg_write_fn reg_write = {}, dev_addr_type dev_addr = {})
-        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type> { buf_ptr, reg_read, reg_write, dev_addr }
+        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type, IoPolicy> { buf_ptr, reg_read, reg_write, dev_addr }
     {
+        set_name(_chip_name, get_num());
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
@@ -118,7 +119,7 @@ public:
     }
     int get_num() const noexcept final { return _counter.get_num(); }
     int get_counts() const noexcept final { return _counter.get_counts(); }
-    std::string get_name() const noexcept final { return get_name(_chip_name, get_num()); }
+    std::string get_name() const noexcept final { return get_name_cstr(); }
     void init() const
     {
 #if defined(CHAPPI_LOG_ENABLE)
@@ -77,72 +77,51 @@ namespace hmc988_registers {
 
     using register_type = uint16_t;
     using register_addr_type = uint16_t;
-    template <typename register_bits_type, register_addr_type register_addr>
-    using register_abstract = ::chappi::register_abstract<register_type, register_bits_type, register_addr_type, register_addr>;
-
-#pragma pack(push, 1)
-
-    union register_bits_00h {
-        struct {
-            register_type read_control : 4;
-            register_type soft_reset : 1;
-        };
-        register_type chip_id;
-    };
-
-    struct register_bits_01h {
-        bool master_chip_enable : 1;
-        bool rx_buffer_enable : 1;
-        bool divider_core_enable : 1;
-        bool output_buffer_enable : 1;
-    };
-
-    struct register_bits_02h {
-        hmc988_divide_ratio divide_ratio_select : 3;
-    };
-
-    struct register_bits_03h {
-        register_type : 4;
-        hmc988_tx_buffer_swing tx_buffer_swing_select : 2;
-        register_type sync_delay_adj : 3;
-    };
-
-    struct register_bits_04h {
-        bool broadcast_mode : 1;
-        bool external_sync_pin_en : 1;
-        bool external_slip_pin_en : 1;
-        bool rx_buffer_dc_bias_select : 1;
-        bool delay_line_enable : 1;
-        bool on_chip_regulator_bypass : 1;
-    };
-
-    struct register_bits_05h {
-        hmc988_gpio_select gpio_select : 3;
-        register_type force_gpo_on_gpo : 1;
-        register_type force_gpo_on_sdo : 1;
-        register_type force_gpo_hiz : 1;
-    };
-
-    struct register_bits_06h {
-        register_type spi_sync_signal : 1;
-        register_type spi_slip_signal : 1;
-        hmc988_output_launch_phase output_launch_phase : 1;
-    };
-
-    struct register_bits_07h {
-        register_type delay_line_setpoint : 6;
-    };
-
-#pragma pack(pop)
-
-    using register_00h = register_abstract<register_bits_00h, 0x00>;
-    using register_01h = register_abstract<register_bits_01h, 0x01>;
-    using register_02h = register_abstract<register_bits_02h, 0x02>;
-    using register_03h = register_abstract<register_bits_03h, 0x03>;
-    using register_04h = register_abstract<register_bits_04h, 0x04>;
-    using register_05h = register_abstract<register_bits_05h, 0x05>;
-    using register_06h = register_abstract<register_bits_06h, 0x06>;
-    using register_07h = register_abstract<register_bits_07h, 0x07>;
+    template <register_addr_type register_addr>
+    using register_abstract = ::chappi::register_abstract<register_type, register_addr_type, register_addr>;
+    template <register_addr_type register_addr, unsigned offset, unsigned width, typename field_type = register_type>
+    using register_field = ::chappi::register_field<register_type, register_addr, offset, width, field_type>;
+
+    using read_control = register_field<0x00, 0, 4>;
+    using soft_reset = register_field<0x00, 4, 1>;
+    using chip_id = register_field<0x00, 0, 16>;
+
+    using master_chip_enable = register_field<0x01, 0, 1, bool>;
+    using rx_buffer_enable = register_field<0x01, 1, 1, bool>;
+    using divider_core_enable = register_field<0x01, 2, 1, bool>;
+    using output_buffer_enable = register_field<0x01, 3, 1, bool>;
+
+    using divide_ratio_select = register_field<0x02, 0, 3, hmc988_divide_ratio>;
+
+    using tx_buffer_swing_select = register_field<0x03, 4, 2, hmc988_tx_buffer_swing>;
+    using sync_delay_adj = register_field<0x03, 6, 3>;
+
+    using broadcast_mode = register_field<0x04, 0, 1, bool>;
+    using external_sync_pin_en = register_field<0x04, 1, 1, bool>;
+    using external_slip_pin_en = register_field<0x04, 2, 1, bool>;
+    using rx_buffer_dc_bias_select = register_field<0x04, 3, 1, bool>;
+    using delay_line_enable = register_field<0x04, 4, 1, bool>;
+    using on_chip_regulator_bypass = register_field<0x04, 5, 1, bool>;
+
+    using gpio_select = register_field<0x05, 0, 3, hmc988_gpio_select>;
+    using force_gpo_on_gpo = register_field<0x05, 3, 1>;
+    using force_gpo_on_sdo = register_field<0x05, 4, 1>;
+    using force_gpo_hiz = register_field<0x05, 5, 1>;
+
+    using spi_sync_signal = register_field<0x06, 0, 1>;
+    using spi_slip_signal = register_field<0x06, 1, 1>;
+    using output_launch_phase = register_field<0x06, 2, 1, hmc988_output_launch_phase>;
+
+    using delay_line_setpoint = register_field<0x07, 0, 6>;
+
+    using register_00h = register_abstract<0x00>;
+    using register_01h = register_abstract<0x01>;
+    using register_02h = register_abstract<0x02>;
+    using register_03h = register_abstract<0x03>;
+    using register_04h = register_abstract<0x04>;
+    using register_05h = register_abstract<0x05>;
+    using register_06h = register_abstract<0x06>;
+    using register_07h = register_abstract<0x07>;
 
 }
 
@@ -152,8 +131,8 @@ namespace detail {
 } // namespace detail
 
 template <typename ErrorType = int, ErrorType NoerrorValue = 0,
-    typename DevAddrType = uint16_t, typename AddrType = uint16_t, typename ValueType = uint16_t>
-class hmc988 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    typename DevAddrType = uint16_t, typename AddrType = uint16_t, typename ValueType = uint16_t, typename IoPolicy = dynamic_io>
+class hmc988 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy> {
     static constexpr auto _chip_name = "HMC988";
     detail::hmc988_counter _counter;
 
@@ -166,8 +145,9 @@ public:
     {
     }
     hmc988(std::streambuf* buf_ptr = {}, reg_read_fn reg_read = {}, reg_write_fn reg_write = {}, dev_addr_type dev_addr = {})
-        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type> { buf_ptr, reg_read, reg_write, dev_addr }
+        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type, IoPolicy> { buf_ptr, reg_read, reg_write, dev_addr }
     {
+        set_name(_chip_name, get_num());
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
@@ -180,14 +160,14 @@ public:
     }
     int get_num() const noexcept final { return _counter.get_num(); }
     int get_counts() const noexcept final { return _counter.get_counts(); }
-    std::string get_name() const noexcept final { return get_name(_chip_name, get_num()); }
+    std::string get_name() const noexcept final { return get_name_cstr(); }
     void reset() const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
         hmc988_registers::register_00h reg {};
-        reg.data.bits.soft_reset = true;
+        reg.set<hmc988_registers::soft_reset>(true);
         _write(reg);
     }
     void reset(error_type& error) const noexcept
@@ -202,7 +182,7 @@ public:
         hmc988_registers::register_00h reg {};
         _write(reg);
         _read(reg);
-        id = reg.data.bits.chip_id;
+        id = reg.get<hmc988_registers::chip_id>();
     }
     value_type read_id() const
     {
@@ -222,10 +202,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_01h reg_01h {};
-        reg_00h.data.bits.read_control = reg_01h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_01h.addr);
         _write(reg_00h);
         _read(reg_01h);
-        reg_01h.data.bits.master_chip_enable = enabled;
+        reg_01h.set<hmc988_registers::master_chip_enable>(enabled);
         _write(reg_01h);
     }
     void chip_enable(bool enabled, error_type& error) const noexcept
@@ -240,10 +220,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_01h reg_01h {};
-        reg_00h.data.bits.read_control = reg_01h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_01h.addr);
         _write(reg_00h);
         _read(reg_01h);
-        enabled = reg_01h.data.bits.master_chip_enable;
+        enabled = reg_01h.get<hmc988_registers::master_chip_enable>();
     }
     bool is_enabled() const
     {
@@ -263,10 +243,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_01h reg_01h {};
-        reg_00h.data.bits.read_control = reg_01h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_01h.addr);
         _write(reg_00h);
         _read(reg_01h);
-        reg_01h.data.bits.rx_buffer_enable = enabled;
+        reg_01h.set<hmc988_registers::rx_buffer_enable>(enabled);
         _write(reg_01h);
     }
     void rx_buffer_enable(bool enabled, error_type& error) const noexcept
@@ -281,10 +261,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_01h reg_01h {};
-        reg_00h.data.bits.read_control = reg_01h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_01h.addr);
         _write(reg_00h);
         _read(reg_01h);
-        enabled = reg_01h.data.bits.rx_buffer_enable;
+        enabled = reg_01h.get<hmc988_registers::rx_buffer_enable>();
     }
     bool is_rx_buffer_enabled() const
     {
@@ -304,10 +284,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_01h reg_01h {};
-        reg_00h.data.bits.read_control = reg_01h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_01h.addr);
         _write(reg_00h);
         _read(reg_01h);
-        reg_01h.data.bits.output_buffer_enable = enabled;
+        reg_01h.set<hmc988_registers::output_buffer_enable>(enabled);
         _write(reg_01h);
     }
     void output_buffer_enable(bool enabled, error_type& error) const noexcept
@@ -322,10 +302,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_01h reg_01h {};
-        reg_00h.data.bits.read_control = reg_01h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_01h.addr);
         _write(reg_00h);
         _read(reg_01h);
-        enabled = reg_01h.data.bits.output_buffer_enable;
+        enabled = reg_01h.get<hmc988_registers::output_buffer_enable>();
     }
     bool is_output_buffer_enabled() const
     {
@@ -345,10 +325,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_01h reg_01h {};
-        reg_00h.data.bits.read_control = reg_01h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_01h.addr);
         _write(reg_00h);
         _read(reg_01h);
-        reg_01h.data.bits.divider_core_enable = enabled;
+        reg_01h.set<hmc988_registers::divider_core_enable>(enabled);
         _write(reg_01h);
     }
     void divider_core_enable(bool enabled, error_type& error) const noexcept
@@ -363,10 +343,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_01h reg_01h {};
-        reg_00h.data.bits.read_control = reg_01h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_01h.addr);
         _write(reg_00h);
         _read(reg_01h);
-        enabled = reg_01h.data.bits.divider_core_enable;
+        enabled = reg_01h.get<hmc988_registers::divider_core_enable>();
     }
     bool is_divider_core_enabled() const
     {
@@ -386,10 +366,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_04h reg_04h {};
-        reg_00h.data.bits.read_control = reg_04h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_04h.addr);
         _write(reg_00h);
         _read(reg_04h);
-        reg_04h.data.bits.delay_line_enable = enabled;
+        reg_04h.set<hmc988_registers::delay_line_enable>(enabled);
         _write(reg_04h);
     }
     void delay_line_enable(bool enabled, error_type& error) const noexcept
@@ -404,10 +384,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_04h reg_04h {};
-        reg_00h.data.bits.read_control = reg_04h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_04h.addr);
         _write(reg_00h);
         _read(reg_04h);
-        enabled = reg_04h.data.bits.delay_line_enable;
+        enabled = reg_04h.get<hmc988_registers::delay_line_enable>();
     }
     bool is_delay_line_enable() const
     {
@@ -427,10 +407,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_04h reg_04h {};
-        reg_00h.data.bits.read_control = reg_04h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_04h.addr);
         _write(reg_00h);
         _read(reg_04h);
-        reg_04h.data.bits.on_chip_regulator_bypass = bypassed;
+        reg_04h.set<hmc988_registers::on_chip_regulator_bypass>(bypassed);
         _write(reg_04h);
     }
     void regulator_bypass(bool bypassed, error_type& error) const noexcept
@@ -445,10 +425,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_04h reg_04h {};
-        reg_00h.data.bits.read_control = reg_04h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_04h.addr);
         _write(reg_00h);
         _read(reg_04h);
-        bypassed = reg_04h.data.bits.on_chip_regulator_bypass;
+        bypassed = reg_04h.get<hmc988_registers::on_chip_regulator_bypass>();
     }
     bool is_regulator_bypass() const
     {
@@ -468,10 +448,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_02h reg_02h {};
-        reg_00h.data.bits.read_control = reg_02h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_02h.addr);
         _write(reg_00h);
         _read(reg_02h);
-        reg_02h.data.bits.divide_ratio_select = ratio;
+        reg_02h.set<hmc988_registers::divide_ratio_select>(ratio);
         _write(reg_02h);
     }
     void set_divide_ratio(hmc988_divide_ratio ratio, error_type& error) const noexcept
@@ -486,10 +466,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_02h reg_02h {};
-        reg_00h.data.bits.read_control = reg_02h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_02h.addr);
         _write(reg_00h);
         _read(reg_02h);
-        ratio = reg_02h.data.bits.divide_ratio_select;
+        ratio = reg_02h.get<hmc988_registers::divide_ratio_select>();
     }
     hmc988_divide_ratio get_divide_ratio() const
     {
@@ -509,10 +489,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_03h reg_03h {};
-        reg_00h.data.bits.read_control = reg_03h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_03h.addr);
         _write(reg_00h);
         _read(reg_03h);
-        reg_03h.data.bits.tx_buffer_swing_select = swing;
+        reg_03h.set<hmc988_registers::tx_buffer_swing_select>(swing);
         _write(reg_03h);
     }
     void set_tx_buffer_swing(hmc988_tx_buffer_swing swing, error_type& error) const noexcept
@@ -527,10 +507,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_03h reg_03h {};
-        reg_00h.data.bits.read_control = reg_03h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_03h.addr);
         _write(reg_00h);
         _read(reg_03h);
-        swing = reg_03h.data.bits.tx_buffer_swing_select;
+        swing = reg_03h.get<hmc988_registers::tx_buffer_swing_select>();
     }
     hmc988_tx_buffer_swing get_tx_buffer_swing() const
     {
@@ -550,28 +530,28 @@ public:
 #endif
         register_00h reg_00h {};
         register_05h reg_05h {};
-        reg_00h.data.bits.read_control = reg_05h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_05h.addr);
         _write(reg_00h);
         _read(reg_05h);
         switch (force.mode) {
         case hmc988_gpo_force_mode::on_gpo_only:
-            reg_05h.data.bits.force_gpo_on_gpo = force.enabled;
+            reg_05h.set<hmc988_registers::force_gpo_on_gpo>(force.enabled);
             break;
         case hmc988_gpo_force_mode::on_sdo_only:
-            reg_05h.data.bits.force_gpo_on_sdo = force.enabled;
+            reg_05h.set<hmc988_registers::force_gpo_on_sdo>(force.enabled);
             break;
         case hmc988_gpo_force_mode::to_hiz:
-            reg_05h.data.bits.force_gpo_hiz = force.enabled;
+            reg_05h.set<hmc988_registers::force_gpo_hiz>(force.enabled);
             break;
         default:
-            throw std::invalid_argument("hmc988::force_gpo: invalid argument");
-            break;
+            raise_error(std::invalid_argument("hmc988::force_gpo: invalid argument"));
+            return;
         }
         _write(reg_05h);
     }
     void force_gpo(const hmc988_gpo_force& force, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<hmc988, error_type, NoerrorValue, hmc988_gpo_force, &hmc988::force_gpo>(this, force, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { force_gpo(force); });
     }
     void is_gpo_forced(hmc988_gpo_force_mode force_mode, bool& enabled) const
     {
@@ -581,22 +561,22 @@ public:
 #endif
         register_00h reg_00h {};
         register_05h reg_05h {};
-        reg_00h.data.bits.read_control = reg_05h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_05h.addr);
         _write(reg_00h);
         _read(reg_05h);
         switch (force_mode) {
         case hmc988_gpo_force_mode::on_gpo_only:
-            enabled = reg_05h.data.bits.force_gpo_on_gpo;
+            enabled = reg_05h.get<hmc988_registers::force_gpo_on_gpo>();
             break;
         case hmc988_gpo_force_mode::on_sdo_only:
-            enabled = reg_05h.data.bits.force_gpo_on_sdo;
+            enabled = reg_05h.get<hmc988_registers::force_gpo_on_sdo>();
             break;
         case hmc988_gpo_force_mode::to_hiz:
-            enabled = reg_05h.data.bits.force_gpo_hiz;
+            enabled = reg_05h.get<hmc988_registers::force_gpo_hiz>();
             break;
         default:
-            throw std::invalid_argument("hmc988::is_gpo_forced: invalid argument");
-            break;
+            raise_error(std::invalid_argument("hmc988::is_gpo_forced: invalid argument"));
+            return;
         }
     }
     bool is_gpo_forced(hmc988_gpo_force_mode force_mode) const
@@ -607,19 +587,20 @@ public:
     }
     bool is_gpo_forced(hmc988_gpo_force_mode force_mode, error_type& error) const noexcept
     {
-        return helpers::noexcept_get_function<hmc988, error_type, NoerrorValue, bool, &hmc988::is_gpo_forced>(this, force_mode, error);
+        return helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { return is_gpo_forced(force_mode); });
     }
     void set_delay_line_setpoint(uint8_t setpoint) const
     {
         if(setpoint > 60){
-            throw std::invalid_argument("hmc988::set_delay_line_setpoint: invalid argument");
+            raise_error(std::invalid_argument("hmc988::set_delay_line_setpoint: invalid argument"));
+            return;
         }
         using namespace hmc988_registers;
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
         register_07h reg_07h {};
-        reg_07h.data.bits.delay_line_setpoint = setpoint;
+        reg_07h.set<hmc988_registers::delay_line_setpoint>(setpoint);
         _write(reg_07h);
     }
     void set_delay_line_setpoint(uint8_t setpoint, error_type& error) const noexcept
@@ -634,10 +615,10 @@ public:
 #endif
         register_00h reg_00h {};
         register_07h reg_07h {};
-        reg_00h.data.bits.read_control = reg_07h.addr;
+        reg_00h.set<hmc988_registers::read_control>(reg_07h.addr);
         _write(reg_00h);
         _read(reg_07h);
-        setpoint = reg_07h.data.bits.delay_line_setpoint;
+        setpoint = reg_07h.get<hmc988_registers::delay_line_setpoint>();
     }
     uint8_t get_delay_line_setpoint() const
     {
@@ -651,15 +632,15 @@ public:
     }
 
 private:
-    template <typename register_bits_type, hmc988_registers::register_addr_type register_addr>
-    void _read(hmc988_registers::register_abstract<register_bits_type, register_addr>& reg) const
+    template <hmc988_registers::register_addr_type register_addr>
+    void _read(hmc988_registers::register_abstract<register_addr>& reg) const
     {
-        read(get_dev_addr(), reg.data.value);
+        read(get_dev_addr(), reg.value);
     }
-    template <typename register_bits_type, hmc988_registers::register_addr_type register_addr>
-    void _write(const hmc988_registers::register_abstract<register_bits_type, register_addr>& reg) const
+    template <hmc988_registers::register_addr_type register_addr>
+    void _write(const hmc988_registers::register_abstract<register_addr>& reg) const
     {
-        write((reg.addr << _addr_offset) | get_dev_addr(), reg.data.value);
+        write((reg.addr << _addr_offset) | get_dev_addr(), reg.value);
     }
 };
 
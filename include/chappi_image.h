@@ -0,0 +1,391 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "chappi_base.h"
+#include "chappi_register.h"
+
+namespace chappi {
+
+// Complete register images of chips in a binary file, little-endian and
+// used in place:
+//
+//   file header, 16 bytes
+//      0  char[4]   magic "CHPI"
+//      4  u16       version
+//      6  u16       image header size
+//      8  u32       images number
+//     12  u32       file size
+//   image headers, one after another
+//      0  char[16]  chip, "LMX2594", zero padded
+//     16  char[24]  profile, zero padded
+//     40  u32       device address
+//     44  u32       first register address
+//     48  u32       registers number
+//     52  u16       value size in bytes
+//     54  u16       flags
+//     56  u32       values offset from the file start, 8-byte aligned
+//     60  u16       last registers number
+//     62  u16       reserved
+//   values, then the u32 addresses of the last registers, 4-byte aligned
+//
+// Registers are written in address order, descending with flag_descending,
+// and the last registers after them in the order listed. Later versions
+// only append fields to the headers, so readers go by the header size.
+namespace image_format {
+    constexpr char magic[4] { 'C', 'H', 'P', 'I' };
+    constexpr uint16_t version { 1 };
+    constexpr std::size_t file_header_size { 16 };
+    constexpr std::size_t image_header_size { 64 };
+    constexpr std::size_t chip_size { 16 };
+    constexpr std::size_t profile_size { 24 };
+    constexpr uint16_t flag_descending { 0x0001 };
+} // namespace image_format
+
+namespace detail {
+    template <typename Type>
+    Type get_le(const uint8_t* buf) noexcept
+    {
+        Type value {};
+        for (std::size_t i { sizeof(Type) }; i != 0; --i) {
+            value = Type((value << 8) | buf[i - 1]);
+        }
+        return value;
+    }
+    template <typename Type>
+    void put_le(uint8_t* buf, Type value) noexcept
+    {
+        for (std::size_t i {}; i < sizeof(Type); ++i) {
+            buf[i] = uint8_t(value & 0xFF);
+            value = Type(value >> 8);
+        }
+    }
+    inline std::size_t image_align(std::size_t offset, std::size_t alignment) noexcept
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+    // Compares a zero padded field of the file with a C string.
+    inline bool image_field_equal(const uint8_t* field, std::size_t size, const char* str) noexcept
+    {
+        const auto length = std::strlen(str);
+        if (length > size || std::memcmp(field, str, length) != 0) {
+            return false;
+        }
+        return length == size || field[length] == 0;
+    }
+    inline std::string image_field_string(const uint8_t* field, std::size_t size)
+    {
+        std::size_t length {};
+        while (length < size && field[length] != 0) {
+            ++length;
+        }
+        return { reinterpret_cast<const char*>(field), length };
+    }
+} // namespace detail
+
+// One image in a file, read straight from the file bytes.
+class register_image {
+    const uint8_t* _file {};
+    const uint8_t* _header {};
+
+public:
+    register_image() = default;
+    register_image(const uint8_t* file, const uint8_t* header) noexcept
+        : _file { file }
+        , _header { header }
+    {
+    }
+    explicit operator bool() const noexcept { return _header != nullptr; }
+    bool is_chip(const char* chip) const noexcept
+    {
+        return detail::image_field_equal(_header, image_format::chip_size, chip);
+    }
+    bool is_profile(const char* profile) const noexcept
+    {
+        return detail::image_field_equal(_header + 16, image_format::profile_size, profile);
+    }
+    std::string get_chip() const { return detail::image_field_string(_header, image_format::chip_size); }
+    std::string get_profile() const { return detail::image_field_string(_header + 16, image_format::profile_size); }
+    uint32_t get_dev_addr() const noexcept { return detail::get_le<uint32_t>(_header + 40); }
+    uint32_t get_first_addr() const noexcept { return detail::get_le<uint32_t>(_header + 44); }
+    uint32_t get_registers_num() const noexcept { return detail::get_le<uint32_t>(_header + 48); }
+    uint16_t get_value_size() const noexcept { return detail::get_le<uint16_t>(_header + 52); }
+    bool is_descending() const noexcept
+    {
+        return (detail::get_le<uint16_t>(_header + 54) & image_format::flag_descending) != 0;
+    }
+    uint16_t get_last_num() const noexcept { return detail::get_le<uint16_t>(_header + 60); }
+    uint32_t get_last(std::size_t pos) const noexcept
+    {
+        return detail::get_le<uint32_t>(_last() + pos * sizeof(uint32_t));
+    }
+    bool is_last(uint32_t addr) const noexcept
+    {
+        const auto last_num = get_last_num();
+        for (std::size_t pos {}; pos < last_num; ++pos) {
+            if (get_last(pos) == addr) {
+                return true;
+            }
+        }
+        return false;
+    }
+    // The value at register position pos, get_value_size() bytes wide.
+    template <typename ValueType>
+    ValueType get_value(std::size_t pos) const noexcept
+    {
+        return detail::get_le<ValueType>(_values() + pos * sizeof(ValueType));
+    }
+
+private:
+    const uint8_t* _values() const noexcept { return _file + detail::get_le<uint32_t>(_header + 56); }
+    const uint8_t* _last() const noexcept
+    {
+        return _file + detail::image_align(detail::get_le<uint32_t>(_header + 56) + get_registers_num() * get_value_size(), 4);
+    }
+};
+
+// The images of a file held in memory, checked once on construction and
+// then used without copying.
+class register_images {
+    const uint8_t* _data {};
+    std::size_t _images_num {};
+    std::size_t _header_size {};
+
+public:
+    register_images() = default;
+    register_images(const void* data, std::size_t size)
+    {
+        if (const auto error = check(data, size)) {
+            detail::throw_exception(std::runtime_error(std::string("chappi::register_images: ") + error));
+        }
+        _data = static_cast<const uint8_t*>(data);
+        _images_num = detail::get_le<uint32_t>(_data + 8);
+        _header_size = detail::get_le<uint16_t>(_data + 6);
+    }
+    // Returns what is wrong with the file, nullptr when it is valid.
+    static const char* check(const void* data, std::size_t size) noexcept
+    {
+        const auto file = static_cast<const uint8_t*>(data);
+        if (size < image_format::file_header_size || std::memcmp(file, image_format::magic, sizeof(image_format::magic)) != 0) {
+            return "not a register images file";
+        }
+        const auto version = detail::get_le<uint16_t>(file + 4);
+        const std::size_t header_size { detail::get_le<uint16_t>(file + 6) };
+        const std::size_t images_num { detail::get_le<uint32_t>(file + 8) };
+        const std::size_t file_size { detail::get_le<uint32_t>(file + 12) };
+        if (version == 0 || header_size < image_format::image_header_size) {
+            return "unsupported version";
+        }
+        if (file_size > size || image_format::file_header_size + images_num * header_size > file_size) {
+            return "truncated file";
+        }
+        for (std::size_t pos {}; pos < images_num; ++pos) {
+            const register_image image { file, file + image_format::file_header_size + pos * header_size };
+            const std::size_t value_size { image.get_value_size() };
+            if (value_size != 1 && value_size != 2 && value_size != 4 && value_size != 8) {
+                return "unsupported value size";
+            }
+            const std::size_t values_offset { detail::get_le<uint32_t>(file + image_format::file_header_size + pos * header_size + 56) };
+            const auto last_offset = detail::image_align(values_offset + std::size_t(image.get_registers_num()) * value_size, 4);
+            if (values_offset % 8 != 0 || last_offset + image.get_last_num() * sizeof(uint32_t) > file_size) {
+                return "image out of the file";
+            }
+            for (std::size_t last {}; last < image.get_last_num(); ++last) {
+                const auto addr = image.get_last(last);
+                if (addr < image.get_first_addr() || addr - image.get_first_addr() >= image.get_registers_num()) {
+                    return "last register out of the image";
+                }
+            }
+        }
+        return nullptr;
+    }
+    std::size_t size() const noexcept { return _images_num; }
+    register_image operator[](std::size_t pos) const noexcept
+    {
+        return { _data, _data + image_format::file_header_size + pos * _header_size };
+    }
+    // Returns an empty image when none matches.
+    register_image find(const char* chip, uint32_t dev_addr, const char* profile) const noexcept
+    {
+        for (std::size_t pos {}; pos < _images_num; ++pos) {
+            const auto image = (*this)[pos];
+            if (image.get_dev_addr() == dev_addr && image.is_chip(chip) && image.is_profile(profile)) {
+                return image;
+            }
+        }
+        return {};
+    }
+};
+
+// Builds a register images file.
+class register_images_writer {
+    struct image_data {
+        std::string chip {};
+        std::string profile {};
+        uint32_t dev_addr {};
+        uint32_t first_addr {};
+        uint32_t registers_num {};
+        uint16_t value_size {};
+        uint16_t flags {};
+        std::vector<uint8_t> values {};
+        std::vector<uint32_t> last {};
+    };
+    std::vector<image_data> _images {};
+
+public:
+    template <typename ValueType>
+    void add(const std::string& chip, const std::string& profile, uint32_t dev_addr, uint32_t first_addr,
+        const ValueType* values, std::size_t registers_num, bool descending = false, std::initializer_list<uint32_t> last = {})
+    {
+        if (chip.size() > image_format::chip_size || profile.size() > image_format::profile_size) {
+            detail::throw_exception(std::invalid_argument("chappi::register_images_writer: chip or profile name too long"));
+        }
+        for (const auto addr : last) {
+            if (addr < first_addr || addr - first_addr >= registers_num) {
+                detail::throw_exception(std::invalid_argument("chappi::register_images_writer: last register out of the image"));
+            }
+        }
+        image_data image { chip, profile, dev_addr, first_addr, uint32_t(registers_num), uint16_t(sizeof(ValueType)),
+            uint16_t((descending) ? image_format::flag_descending : 0), std::vector<uint8_t>(registers_num * sizeof(ValueType)), last };
+        for (std::size_t pos {}; pos < registers_num; ++pos) {
+            detail::put_le(image.values.data() + pos * sizeof(ValueType), values[pos]);
+        }
+        _images.push_back(std::move(image));
+    }
+    std::vector<uint8_t> get_data() const
+    {
+        auto offset = detail::image_align(image_format::file_header_size + _images.size() * image_format::image_header_size, 8);
+        std::vector<std::size_t> values_offsets {};
+        for (const auto& image : _images) {
+            values_offsets.push_back(offset);
+            offset = detail::image_align(offset + image.values.size(), 4) + image.last.size() * sizeof(uint32_t);
+            offset = detail::image_align(offset, 8);
+        }
+        std::vector<uint8_t> data(offset);
+        std::memcpy(data.data(), image_format::magic, sizeof(image_format::magic));
+        detail::put_le(data.data() + 4, image_format::version);
+        detail::put_le(data.data() + 6, uint16_t(image_format::image_header_size));
+        detail::put_le(data.data() + 8, uint32_t(_images.size()));
+        detail::put_le(data.data() + 12, uint32_t(data.size()));
+        for (std::size_t pos {}; pos < _images.size(); ++pos) {
+            const auto& image = _images[pos];
+            const auto header = data.data() + image_format::file_header_size + pos * image_format::image_header_size;
+            std::memcpy(header, image.chip.data(), image.chip.size());
+            std::memcpy(header + 16, image.profile.data(), image.profile.size());
+            detail::put_le(header + 40, image.dev_addr);
+            detail::put_le(header + 44, image.first_addr);
+            detail::put_le(header + 48, image.registers_num);
+            detail::put_le(header + 52, image.value_size);
+            detail::put_le(header + 54, image.flags);
+            detail::put_le(header + 56, uint32_t(values_offsets[pos]));
+            detail::put_le(header + 60, uint16_t(image.last.size()));
+            std::memcpy(data.data() + values_offsets[pos], image.values.data(), image.values.size());
+            auto last = data.data() + detail::image_align(values_offsets[pos] + image.values.size(), 4);
+            for (const auto addr : image.last) {
+                detail::put_le(last, addr);
+                last += sizeof(uint32_t);
+            }
+        }
+        return data;
+    }
+    void save(const std::string& path) const
+    {
+        const auto data = get_data();
+        std::ofstream file { path, std::ios::binary | std::ios::trunc };
+        file.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+        if (!file) {
+            detail::throw_exception(std::runtime_error("chappi::register_images_writer: cannot write " + path));
+        }
+    }
+};
+
+// Programs the chip from the image with batch writes of up to
+// image_chunk_max registers, straight from the file bytes. The driver's
+// shadow registers are bypassed, for drivers that keep a map
+// image_to_registers_map() and the driver's own update are the way.
+template <typename ErrorType, ErrorType NoerrorValue, typename DevAddrType, typename AddrType, typename ValueType, typename IoPolicy>
+void load_image(const chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy>& chip, const register_image& image)
+{
+    if (image.get_value_size() != sizeof(ValueType)) {
+        detail::raise_error<ErrorType>(std::invalid_argument("chappi::load_image: image value size does not match the chip"));
+        return;
+    }
+    const std::size_t image_chunk_max { 128 };
+    reg_data<AddrType, ValueType> chunk[image_chunk_max];
+    std::size_t chunk_size {};
+    const auto first_addr = image.get_first_addr();
+    const std::size_t registers_num { image.get_registers_num() };
+    auto add_register = [&](std::size_t pos) {
+        chunk[chunk_size++] = { AddrType(first_addr + pos), image.get_value<ValueType>(pos) };
+        if (chunk_size == image_chunk_max) {
+            chip.write_batch(chunk, chunk_size);
+            chunk_size = 0;
+        }
+    };
+    for (std::size_t i {}; i < registers_num; ++i) {
+        const auto pos = (image.is_descending()) ? registers_num - 1 - i : i;
+        if (!image.is_last(uint32_t(first_addr + pos))) {
+            add_register(pos);
+        }
+    }
+    for (std::size_t last {}; last < image.get_last_num(); ++last) {
+        add_register(image.get_last(last) - first_addr);
+    }
+    if (chunk_size != 0) {
+        chip.write_batch(chunk, chunk_size);
+    }
+}
+template <typename ErrorType, ErrorType NoerrorValue, typename DevAddrType, typename AddrType, typename ValueType, typename IoPolicy>
+void load_image(const chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy>& chip, const register_image& image,
+    ErrorType& error) noexcept
+{
+    helpers::noexcept_invoke<ErrorType, NoerrorValue>(error, [&] { load_image(chip, image); });
+}
+
+// Copies the image into a driver's register map. Returns false, leaving
+// the map alone, when the value size differs or the image does not fit.
+template <typename register_type, std::size_t register_max_num>
+bool image_to_registers_map(const register_image& image, registers_map<register_type, register_max_num>& map) noexcept
+{
+    if (image.get_value_size() != sizeof(register_type)
+        || std::size_t(image.get_first_addr()) + image.get_registers_num() > register_max_num) {
+        return false;
+    }
+    for (std::size_t pos {}; pos < image.get_registers_num(); ++pos) {
+        map.array[image.get_first_addr() + pos] = image.get_value<register_type>(pos);
+    }
+    return true;
+}
+
+} // namespace chappi
@@ -36,8 +36,8 @@ namespace detail {
 } // namespace detail
 
 template <typename ErrorType = int, ErrorType NoerrorValue = 0,
-    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint16_t>
-class ina219 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint16_t, typename IoPolicy = dynamic_io>
+class ina219 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy> {
     static constexpr auto _chip_name = "INA219";
     detail::ina219_counter _counter;
 
@@ -48,8 +48,9 @@ public:
     {
     }
     ina219(std::streambuf* buf_ptr = {}, reg_read_fn reg_read = {}, reg_write_fn reg_write = {}, dev_addr_type dev_addr = {})
-        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type> { buf_ptr, reg_read, reg_write, dev_addr }
+        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type, IoPolicy> { buf_ptr, reg_read, reg_write, dev_addr }
     {
+        set_name(_chip_name, get_num());
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
@@ -62,7 +63,13 @@ public:
     }
     int get_num() const noexcept final { return _counter.data.get_num(); }
     int get_counts() const noexcept final { return _counter.data.get_counts(); }
-    std::string get_name() const noexcept final { return get_name(_chip_name, get_num()); }
+    std::string get_name() const noexcept final { return get_name_cstr(); }
+    void setup_cache(cache_mode mode)
+    {
+        setup_cache(mode, 0x06);
+        // The self-clearing RST bit of 0x00 must reach the chip at once.
+        set_volatile(0x00, 5);
+    }
     void configure(value_type value) const
     {
 #if defined(CHAPPI_LOG_ENABLE)
@@ -83,6 +90,10 @@ public:
         read(0x00, value);
         value |= (0x8000);
         write(0x00, value);
+        if (error_raised()) {
+            return;
+        }
+        invalidate_cache();
     }
     void reset(error_type& error) const noexcept
     {
@@ -0,0 +1,181 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "chappi_base.h"
+#include "chappi_linux_io.h"
+
+namespace chappi {
+
+// Register access through /dev/i2c-N with the I2C_RDWR ioctl. A register
+// read is one combined transfer: the register address is written and the
+// value read back after a repeated start. Block transfers rely on the address
+// auto-increment of the chip and take one ioctl per block_max registers, a
+// batch takes one ioctl per I2C_RDWR_IOCTL_MAX_MSGS registers. Addresses and
+// values are sent MSB first. A failed transfer returns errno as the error.
+//
+// The class can serve as the IoPolicy of a driver, or its functions can be
+// installed into a dynamic_io chip with attach().
+template <typename ErrorType = int, ErrorType NoerrorValue = 0,
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t, typename Sys = linux_sys>
+class linux_i2c {
+public:
+    using error_type = ErrorType;
+    using dev_addr_type = DevAddrType;
+    using addr_type = AddrType;
+    using value_type = ValueType;
+    using reg_data_type = reg_data<addr_type, value_type>;
+    static constexpr std::size_t block_max { 64 };
+
+    linux_i2c() = default;
+    explicit linux_i2c(const std::string& path)
+        : _device { path }
+    {
+    }
+    explicit linux_i2c(int fd) noexcept
+        : _device { fd }
+    {
+    }
+    void open(const std::string& path) { _device.open(path); }
+    void close() noexcept { _device.close(); }
+    bool is_open() const noexcept { return _device.is_open(); }
+    error_type read(dev_addr_type dev_addr, addr_type addr, value_type& value) const
+    {
+        return read_block(dev_addr, addr, &value, 1);
+    }
+    error_type write(dev_addr_type dev_addr, addr_type addr, value_type value) const
+    {
+        return write_block(dev_addr, addr, &value, 1);
+    }
+    error_type read_block(dev_addr_type dev_addr, addr_type addr, value_type* values, std::size_t count) const
+    {
+        uint8_t addr_buf[_addr_size];
+        uint8_t value_buf[block_max * _value_size];
+        for (std::size_t done {}; done < count;) {
+            const auto chunk = (count - done < block_max) ? count - done : block_max;
+            detail::put_be(addr_buf, addr_type(addr + done));
+            i2c_msg msgs[2] {
+                { __u16(dev_addr), 0, __u16(_addr_size), addr_buf },
+                { __u16(dev_addr), I2C_M_RD, __u16(chunk * _value_size), value_buf }
+            };
+            const auto error = _transfer(msgs, 2);
+            if (error != NoerrorValue) {
+                return error;
+            }
+            for (std::size_t i {}; i < chunk; ++i) {
+                values[done + i] = detail::get_be<value_type>(&value_buf[i * _value_size]);
+            }
+            done += chunk;
+        }
+        return NoerrorValue;
+    }
+    error_type write_block(dev_addr_type dev_addr, addr_type addr, const value_type* values, std::size_t count) const
+    {
+        uint8_t buf[_addr_size + block_max * _value_size];
+        for (std::size_t done {}; done < count;) {
+            const auto chunk = (count - done < block_max) ? count - done : block_max;
+            detail::put_be(buf, addr_type(addr + done));
+            for (std::size_t i {}; i < chunk; ++i) {
+                detail::put_be(&buf[_addr_size + i * _value_size], values[done + i]);
+            }
+            i2c_msg msg { __u16(dev_addr), 0, __u16(_addr_size + chunk * _value_size), buf };
+            const auto error = _transfer(&msg, 1);
+            if (error != NoerrorValue) {
+                return error;
+            }
+            done += chunk;
+        }
+        return NoerrorValue;
+    }
+    error_type write_batch(dev_addr_type dev_addr, const reg_data_type* data, std::size_t count) const
+    {
+        const std::size_t msgs_max { I2C_RDWR_IOCTL_MAX_MSGS };
+        const std::size_t msg_size { _addr_size + _value_size };
+        uint8_t buf[msgs_max * msg_size];
+        i2c_msg msgs[msgs_max];
+        for (std::size_t done {}; done < count;) {
+            const auto chunk = (count - done < msgs_max) ? count - done : msgs_max;
+            for (std::size_t i {}; i < chunk; ++i) {
+                auto msg_buf = &buf[i * msg_size];
+                detail::put_be(msg_buf, data[done + i].addr);
+                detail::put_be(msg_buf + _addr_size, data[done + i].value);
+                msgs[i] = i2c_msg { __u16(dev_addr), 0, __u16(msg_size), msg_buf };
+            }
+            const auto error = _transfer(msgs, chunk);
+            if (error != NoerrorValue) {
+                return error;
+            }
+            done += chunk;
+        }
+        return NoerrorValue;
+    }
+    template <typename ChipType>
+    void attach(ChipType& chip, dev_addr_type dev_addr) const
+    {
+        static_assert(std::is_same<typename ChipType::error_type, error_type>::value
+                && std::is_same<typename ChipType::dev_addr_type, dev_addr_type>::value
+                && std::is_same<typename ChipType::addr_type, addr_type>::value
+                && std::is_same<typename ChipType::value_type, value_type>::value,
+            "chip and bus register types differ");
+        chip.setup_io(
+            [this](dev_addr_type dev_addr, addr_type addr, value_type& value) { return read(dev_addr, addr, value); },
+            [this](dev_addr_type dev_addr, addr_type addr, value_type value) { return write(dev_addr, addr, value); },
+            dev_addr);
+        chip.setup_block_io(
+            [this](dev_addr_type dev_addr, addr_type addr, value_type* values, std::size_t count) {
+                return read_block(dev_addr, addr, values, count);
+            },
+            [this](dev_addr_type dev_addr, addr_type addr, const value_type* values, std::size_t count) {
+                return write_block(dev_addr, addr, values, count);
+            });
+        chip.setup_batch_io(
+            [this](dev_addr_type dev_addr, const reg_data_type* data, std::size_t count) {
+                return write_batch(dev_addr, data, count);
+            });
+    }
+
+private:
+    static constexpr std::size_t _addr_size { sizeof(addr_type) };
+    static constexpr std::size_t _value_size { sizeof(value_type) };
+    error_type _transfer(i2c_msg* msgs, std::size_t count) const noexcept
+    {
+        i2c_rdwr_ioctl_data data { msgs, __u32(count) };
+        const auto error = _device.ioctl(I2C_RDWR, &data);
+        return (error != 0) ? error_type(error) : NoerrorValue;
+    }
+
+    linux_device<Sys> _device {};
+};
+
+} // namespace chappi
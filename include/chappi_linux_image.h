@@ -0,0 +1,125 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#pragma once
+
+#if !defined(__linux__)
+#error "chappi_linux_image.h is only available on Linux"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "chappi_except.h"
+#include "chappi_image.h"
+
+namespace chappi {
+
+// Maps a register images file read-only. The images are checked once when
+// the file is opened and then programmed from the mapping, pages are read
+// in only for the images used.
+class linux_image_file {
+public:
+    linux_image_file() = default;
+    explicit linux_image_file(const std::string& path) { open(path); }
+    linux_image_file(const linux_image_file&) = delete;
+    linux_image_file& operator=(const linux_image_file&) = delete;
+    linux_image_file(linux_image_file&& other) noexcept
+        : _data { other._data }
+        , _size { other._size }
+        , _images { other._images }
+    {
+        other._data = nullptr;
+        other._size = 0;
+        other._images = {};
+    }
+    linux_image_file& operator=(linux_image_file&& other) noexcept
+    {
+        if (this != &other) {
+            close();
+            _data = other._data;
+            _size = other._size;
+            _images = other._images;
+            other._data = nullptr;
+            other._size = 0;
+            other._images = {};
+        }
+        return *this;
+    }
+    ~linux_image_file() noexcept { close(); }
+    void open(const std::string& path)
+    {
+        close();
+        const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            detail::throw_exception(std::system_error(errno, std::generic_category(), path));
+        }
+        struct stat status {};
+        if (::fstat(fd, &status) < 0) {
+            const auto error = errno;
+            ::close(fd);
+            detail::throw_exception(std::system_error(error, std::generic_category(), path));
+        }
+        const auto size = std::size_t(status.st_size);
+        void* data { (size != 0) ? ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED };
+        const auto error = errno;
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            detail::throw_exception(std::system_error((size != 0) ? error : EINVAL, std::generic_category(), path));
+        }
+        if (const auto message = register_images::check(data, size)) {
+            ::munmap(data, size);
+            detail::throw_exception(std::runtime_error(path + ": " + message));
+        }
+        _data = data;
+        _size = size;
+        _images = register_images { _data, _size };
+    }
+    void close() noexcept
+    {
+        if (_data) {
+            ::munmap(_data, _size);
+            _data = nullptr;
+            _size = 0;
+            _images = {};
+        }
+    }
+    bool is_open() const noexcept { return _data != nullptr; }
+    const register_images& get_images() const noexcept { return _images; }
+
+private:
+    void* _data {};
+    std::size_t _size {};
+    register_images _images {};
+};
+
+} // namespace chappi
@@ -0,0 +1,132 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#if !defined(__linux__)
+#error "chappi_linux_io.h is only available on Linux"
+#endif
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+#include "chappi_except.h"
+
+namespace chappi {
+
+// The system calls used by the Linux backends. A test can pass its own type
+// with the same static functions to run a backend without a device node.
+struct linux_sys {
+    static int open(const char* path, int flags) noexcept { return ::open(path, flags); }
+    static int close(int fd) noexcept { return ::close(fd); }
+    static int ioctl(int fd, unsigned long request, void* arg) noexcept { return ::ioctl(fd, request, arg); }
+};
+
+// Owns the file descriptor of a device node.
+template <typename Sys = linux_sys>
+class linux_device {
+public:
+    linux_device() = default;
+    explicit linux_device(const std::string& path) { open(path); }
+    explicit linux_device(int fd) noexcept
+        : _fd { fd }
+    {
+    }
+    linux_device(const linux_device&) = delete;
+    linux_device& operator=(const linux_device&) = delete;
+    linux_device(linux_device&& other) noexcept
+        : _fd { other._fd }
+    {
+        other._fd = -1;
+    }
+    linux_device& operator=(linux_device&& other) noexcept
+    {
+        if (this != &other) {
+            close();
+            _fd = other._fd;
+            other._fd = -1;
+        }
+        return *this;
+    }
+    ~linux_device() noexcept { close(); }
+    void open(const std::string& path)
+    {
+        close();
+        _fd = Sys::open(path.c_str(), O_RDWR);
+        if (_fd < 0) {
+            detail::throw_exception(std::system_error(errno, std::generic_category(), path));
+        }
+    }
+    void close() noexcept
+    {
+        if (_fd >= 0) {
+            Sys::close(_fd);
+            _fd = -1;
+        }
+    }
+    bool is_open() const noexcept { return _fd >= 0; }
+    int get_fd() const noexcept { return _fd; }
+    // Returns 0 on success, otherwise the errno of the failed call.
+    int ioctl(unsigned long request, void* arg) const noexcept
+    {
+        if (Sys::ioctl(_fd, request, arg) < 0) {
+            return (errno != 0) ? errno : EIO;
+        }
+        return 0;
+    }
+
+private:
+    int _fd { -1 };
+};
+
+namespace detail {
+    // Registers wider than a byte go over the wire MSB first.
+    template <typename Type>
+    void put_be(uint8_t* buf, Type value) noexcept
+    {
+        for (std::size_t i { sizeof(Type) }; i != 0; --i) {
+            buf[i - 1] = uint8_t(value & 0xFF);
+            value = Type(value >> 8);
+        }
+    }
+    template <typename Type>
+    Type get_be(const uint8_t* buf) noexcept
+    {
+        Type value {};
+        for (std::size_t i {}; i < sizeof(Type); ++i) {
+            value = Type((value << 8) | buf[i]);
+        }
+        return value;
+    }
+} // namespace detail
+
+} // namespace chappi
@@ -0,0 +1,258 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <linux/spi/spidev.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "chappi_base.h"
+#include "chappi_linux_io.h"
+
+namespace chappi {
+
+// Layout of one SPI frame, sent MSB first: an address field of addr_bits
+// followed by value_bits of data. The register address sits at addr_shift
+// within the address field, read_flag or write_flag is ORed into it. The
+// frame has to be 8 to 32 bits long and a whole number of bytes.
+struct spi_frame_format {
+    unsigned addr_bits {};
+    unsigned value_bits {};
+    unsigned addr_shift {};
+    uint32_t read_flag {};
+    uint32_t write_flag {};
+};
+
+namespace spi_frames {
+    // R/W bit, 7-bit address, 16-bit value.
+    constexpr spi_frame_format lmx2594 { 8, 16, 0, 0x80, 0x00 };
+    // 7-bit address, R/W bit, 8-bit value.
+    constexpr spi_frame_format ltc6953 { 8, 8, 1, 0x01, 0x00 };
+    // 16-bit data word without an address.
+    constexpr spi_frame_format ad5621 { 0, 16, 0, 0x00, 0x00 };
+} // namespace spi_frames
+
+// Register access through /dev/spidevB.C. Every register is one frame, and
+// a block or a batch goes out as a single SPI_IOC_MESSAGE of up to
+// transfers_max frames with the chip select released between frames. Reads
+// are full duplex, the value is taken from the last value_bits clocked in.
+// The device node selects the chip, so dev_addr is ignored. A failed
+// transfer returns errno as the error.
+//
+// The class can serve as the IoPolicy of a driver, or its functions can be
+// installed into a dynamic_io chip with attach().
+template <typename ErrorType = int, ErrorType NoerrorValue = 0,
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t, typename Sys = linux_sys>
+class linux_spi {
+public:
+    using error_type = ErrorType;
+    using dev_addr_type = DevAddrType;
+    using addr_type = AddrType;
+    using value_type = ValueType;
+    using reg_data_type = reg_data<addr_type, value_type>;
+    static constexpr std::size_t transfers_max { 128 };
+
+    linux_spi() = default;
+    explicit linux_spi(const spi_frame_format& format)
+    {
+        set_frame_format(format);
+    }
+    linux_spi(const std::string& path, const spi_frame_format& format)
+        : _device { path }
+    {
+        set_frame_format(format);
+    }
+    linux_spi(int fd, const spi_frame_format& format)
+        : _device { fd }
+    {
+        set_frame_format(format);
+    }
+    void open(const std::string& path) { _device.open(path); }
+    void close() noexcept { _device.close(); }
+    bool is_open() const noexcept { return _device.is_open(); }
+    void set_frame_format(const spi_frame_format& format)
+    {
+        const auto frame_bits = format.addr_bits + format.value_bits;
+        if (frame_bits < 8 || frame_bits > 32 || frame_bits % 8 != 0 || format.value_bits > 8 * sizeof(value_type)) {
+            detail::throw_exception(std::invalid_argument("chappi::linux_spi: unsupported frame format"));
+        }
+        _format = format;
+    }
+    const spi_frame_format& get_frame_format() const noexcept { return _format; }
+    // Sets the SPI mode (SPI_MODE_0..3) and the clock rate, 0 keeps the
+    // rate configured for the device.
+    error_type configure(uint8_t mode, uint32_t speed_hz)
+    {
+        auto error = _device.ioctl(SPI_IOC_WR_MODE, &mode);
+        if (error == 0 && speed_hz != 0) {
+            error = _device.ioctl(SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz);
+        }
+        if (error != 0) {
+            return error_type(error);
+        }
+        _speed_hz = speed_hz;
+        return NoerrorValue;
+    }
+    error_type read(dev_addr_type dev_addr, addr_type addr, value_type& value) const
+    {
+        return read_block(dev_addr, addr, &value, 1);
+    }
+    error_type write(dev_addr_type dev_addr, addr_type addr, value_type value) const
+    {
+        return write_block(dev_addr, addr, &value, 1);
+    }
+    error_type read_block(dev_addr_type, addr_type addr, value_type* values, std::size_t count) const
+    {
+        uint32_t frames[transfers_max];
+        for (std::size_t done {}; done < count;) {
+            const auto chunk = (count - done < transfers_max) ? count - done : transfers_max;
+            for (std::size_t i {}; i < chunk; ++i) {
+                frames[i] = _frame(addr_type(addr + done + i), {}, true);
+            }
+            const auto error = _transfer(frames, chunk, true);
+            if (error != NoerrorValue) {
+                return error;
+            }
+            for (std::size_t i {}; i < chunk; ++i) {
+                values[done + i] = value_type(frames[i] & _value_mask());
+            }
+            done += chunk;
+        }
+        return NoerrorValue;
+    }
+    error_type write_block(dev_addr_type, addr_type addr, const value_type* values, std::size_t count) const
+    {
+        uint32_t frames[transfers_max];
+        for (std::size_t done {}; done < count;) {
+            const auto chunk = (count - done < transfers_max) ? count - done : transfers_max;
+            for (std::size_t i {}; i < chunk; ++i) {
+                frames[i] = _frame(addr_type(addr + done + i), values[done + i], false);
+            }
+            const auto error = _transfer(frames, chunk, false);
+            if (error != NoerrorValue) {
+                return error;
+            }
+            done += chunk;
+        }
+        return NoerrorValue;
+    }
+    error_type write_batch(dev_addr_type, const reg_data_type* data, std::size_t count) const
+    {
+        uint32_t frames[transfers_max];
+        for (std::size_t done {}; done < count;) {
+            const auto chunk = (count - done < transfers_max) ? count - done : transfers_max;
+            for (std::size_t i {}; i < chunk; ++i) {
+                frames[i] = _frame(data[done + i].addr, data[done + i].value, false);
+            }
+            const auto error = _transfer(frames, chunk, false);
+            if (error != NoerrorValue) {
+                return error;
+            }
+            done += chunk;
+        }
+        return NoerrorValue;
+    }
+    template <typename ChipType>
+    void attach(ChipType& chip) const
+    {
+        static_assert(std::is_same<typename ChipType::error_type, error_type>::value
+                && std::is_same<typename ChipType::dev_addr_type, dev_addr_type>::value
+                && std::is_same<typename ChipType::addr_type, addr_type>::value
+                && std::is_same<typename ChipType::value_type, value_type>::value,
+            "chip and bus register types differ");
+        chip.setup_io(
+            [this](dev_addr_type dev_addr, addr_type addr, value_type& value) { return read(dev_addr, addr, value); },
+            [this](dev_addr_type dev_addr, addr_type addr, value_type value) { return write(dev_addr, addr, value); });
+        chip.setup_block_io(
+            [this](dev_addr_type dev_addr, addr_type addr, value_type* values, std::size_t count) {
+                return read_block(dev_addr, addr, values, count);
+            },
+            [this](dev_addr_type dev_addr, addr_type addr, const value_type* values, std::size_t count) {
+                return write_block(dev_addr, addr, values, count);
+            });
+        chip.setup_batch_io(
+            [this](dev_addr_type dev_addr, const reg_data_type* data, std::size_t count) {
+                return write_batch(dev_addr, data, count);
+            });
+    }
+
+private:
+    uint32_t _value_mask() const noexcept
+    {
+        return (_format.value_bits >= 32) ? ~uint32_t {} : (uint32_t(1) << _format.value_bits) - 1;
+    }
+    uint32_t _frame(addr_type addr, value_type value, bool read) const noexcept
+    {
+        uint32_t addr_field { uint32_t(addr) << _format.addr_shift };
+        addr_field |= (read) ? _format.read_flag : _format.write_flag;
+        const uint32_t value_field { uint32_t(value) & _value_mask() };
+        return (_format.addr_bits != 0) ? (addr_field << _format.value_bits) | value_field : value_field;
+    }
+    // Sends the frames in one message and replaces them with the received
+    // frames when read is set.
+    error_type _transfer(uint32_t* frames, std::size_t count, bool read) const
+    {
+        const std::size_t frame_size { (_format.addr_bits + _format.value_bits) / 8 };
+        uint8_t tx_buf[transfers_max * 4];
+        uint8_t rx_buf[transfers_max * 4];
+        spi_ioc_transfer transfers[transfers_max] {};
+        for (std::size_t i {}; i < count; ++i) {
+            auto tx = &tx_buf[i * frame_size];
+            for (std::size_t byte {}; byte < frame_size; ++byte) {
+                tx[byte] = uint8_t(frames[i] >> (8 * (frame_size - 1 - byte)));
+            }
+            transfers[i].tx_buf = uintptr_t(tx);
+            transfers[i].rx_buf = (read) ? uintptr_t(&rx_buf[i * frame_size]) : 0;
+            transfers[i].len = __u32(frame_size);
+            transfers[i].speed_hz = _speed_hz;
+            transfers[i].bits_per_word = 8;
+            transfers[i].cs_change = (i + 1 < count) ? 1 : 0;
+        }
+        const auto error = _device.ioctl(_IOC(_IOC_WRITE, SPI_IOC_MAGIC, 0, SPI_MSGSIZE(count)), transfers);
+        if (error != 0) {
+            return error_type(error);
+        }
+        if (read) {
+            for (std::size_t i {}; i < count; ++i) {
+                frames[i] = 0;
+                for (std::size_t byte {}; byte < frame_size; ++byte) {
+                    frames[i] = (frames[i] << 8) | rx_buf[i * frame_size + byte];
+                }
+            }
+        }
+        return NoerrorValue;
+    }
+
+    linux_device<Sys> _device {};
+    spi_frame_format _format { 8, 8 * (sizeof(value_type) < 3 ? sizeof(value_type) : 3), 0, 0x80, 0x00 };
+    uint32_t _speed_hz {};
+};
+
+} // namespace chappi
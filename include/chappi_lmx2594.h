@@ -26,9 +26,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <cmath>
-#include <forward_list>
 #include <thread>
 
 #ifdef _MSC_VER
@@ -86,34 +87,9 @@ namespace lmx2594_constants {
 
 namespace lmx2594_registers {
 
-#pragma pack(push, 1)
-
     using register_type = uint16_t;
-
-    template <typename register_bits_type>
-    union register_basic {
-        register_type reg {};
-        register_bits_type bits;
-    };
-
-    struct register_common {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    template <std::size_t register_addr, unsigned offset, unsigned width, typename field_type = register_type>
+    using register_field = ::chappi::register_field<register_type, register_addr, offset, width, field_type>;
 
     enum class POWERDOWN_type : register_type {
         normal,
@@ -156,22 +132,15 @@ namespace lmx2594_registers {
         freq_ramping_mode
     };
 
-    struct register_R0 {
-        POWERDOWN_type POWERDOWN : 1;
-        RESET_type RESET : 1;
-        MUXOUT_LD_SEL_type MUXOUT_LD_SEL : 1;
-        FCAL_EN_type FCAL_EN : 1;
-        const register_type D4 : 1;
-        FCAL_LPFD_ADJ_type FCAL_LPFD_ADJ : 2;
-        FCAL_HPFD_ADJ_type FCAL_HPFD_ADJ : 2;
-        OUT_MUTE_type OUT_MUTE : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        VCO_PHASE_SYNC_type VCO_PHASE_SYNC : 1;
-        RAMP_EN_type RAMP_EN : 1;
-    };
+    using POWERDOWN = register_field<0, 0, 1, POWERDOWN_type>;
+    using RESET = register_field<0, 1, 1, RESET_type>;
+    using MUXOUT_LD_SEL = register_field<0, 2, 1, MUXOUT_LD_SEL_type>;
+    using FCAL_EN = register_field<0, 3, 1, FCAL_EN_type>;
+    using FCAL_LPFD_ADJ = register_field<0, 5, 2, FCAL_LPFD_ADJ_type>;
+    using FCAL_HPFD_ADJ = register_field<0, 7, 2, FCAL_HPFD_ADJ_type>;
+    using OUT_MUTE = register_field<0, 9, 1, OUT_MUTE_type>;
+    using VCO_PHASE_SYNC = register_field<0, 14, 1, VCO_PHASE_SYNC_type>;
+    using RAMP_EN = register_field<0, 15, 1, RAMP_EN_type>;
 
     enum class CAL_CLK_DIV_type : register_type {
         div1,
@@ -180,58 +149,16 @@ namespace lmx2594_registers {
         div8
     };
 
-    struct register_R1 {
-        CAL_CLK_DIV_type CAL_CLK_DIV : 3;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using CAL_CLK_DIV = register_field<1, 0, 3, CAL_CLK_DIV_type>;
 
-    struct register_R4 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        register_type ACAL_CMP_DLY : 8;
-    };
+    using ACAL_CMP_DLY = register_field<4, 8, 8>;
 
     enum class OUT_FORCE_type : register_type {
         disabled,
         forced
     };
 
-    struct register_R7 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        OUT_FORCE_type OUT_FORCE : 1;
-        const register_type D15 : 1;
-    };
+    using OUT_FORCE = register_field<7, 14, 1, OUT_FORCE_type>;
 
     enum class VCO_CAPCTRL_FORCE_type : register_type {
         disabled,
@@ -242,48 +169,15 @@ namespace lmx2594_registers {
         forced
     };
 
-    struct register_R8 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        VCO_CAPCTRL_FORCE_type VCO_CAPCTRL_FORCE : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        VCO_DACISET_FORCE_type VCO_DACISET_FORCE : 1;
-        const register_type D15 : 1;
-    };
+    using VCO_CAPCTRL_FORCE = register_field<8, 11, 1, VCO_CAPCTRL_FORCE_type>;
+    using VCO_DACISET_FORCE = register_field<8, 14, 1, VCO_DACISET_FORCE_type>;
 
     enum class OSC_2X_type : register_type {
         disabled,
         low_noise_freq_doubler
     };
 
-    struct register_R9 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        OSC_2X_type OSC_2X : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using OSC_2X = register_field<9, 12, 1, OSC_2X_type>;
 
     enum class MULT_type : register_type {
         bypass = 1,
@@ -294,40 +188,11 @@ namespace lmx2594_registers {
         mul7
     };
 
-    struct register_R10 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        MULT_type MULT : 5;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using MULT = register_field<10, 7, 5, MULT_type>;
 
-    struct register_R11 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        register_type PLL_R : 8;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using PLL_R = register_field<11, 4, 8>;
 
-    struct register_R12 {
-        register_type PLL_R_PRE : 12;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using PLL_R_PRE = register_field<12, 0, 12>;
 
     enum class CPG_type : register_type {
         current_0_mA = 0,
@@ -338,56 +203,13 @@ namespace lmx2594_registers {
         current_15_mA = 7
     };
 
-    struct register_R14 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        CPG_type CPG : 3;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using CPG = register_field<14, 4, 3, CPG_type>;
 
-    struct register_R16 {
-        register_type VCO_DACISET : 9;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using VCO_DACISET = register_field<16, 0, 9>;
 
-    struct register_R17 {
-        register_type VCO_DACISET_STRT : 9;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using VCO_DACISET_STRT = register_field<17, 0, 9>;
 
-    struct register_R19 {
-        register_type VCO_CAPCTRL : 8;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using VCO_CAPCTRL = register_field<19, 0, 8>;
 
     enum class VCO_SEL_type : register_type {
         not_used,
@@ -405,110 +227,39 @@ namespace lmx2594_registers {
         enabled
     };
 
-    struct register_R20 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        VCO_SEL_FORCE_type VCO_SEL_FORCE : 1;
-        VCO_SEL_type VCO_SEL : 3;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using VCO_SEL_FORCE = register_field<20, 10, 1, VCO_SEL_FORCE_type>;
+    using VCO_SEL = register_field<20, 11, 3, VCO_SEL_type>;
 
     enum class SEG1_EN_type : register_type {
         disabled,
         driver_buffer_enabled
     };
 
-    struct register_R31 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        SEG1_EN_type SEG1_EN : 1;
-        const register_type D15 : 1;
-    };
+    using SEG1_EN = register_field<31, 14, 1, SEG1_EN_type>;
 
-    struct register_R34 {
-        register_type PLL_N_18_16 : 3;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using PLL_N_18_16 = register_field<34, 0, 3>;
 
-    struct register_R36 {
-        register_type PLL_N_15_0;
-    };
+    using PLL_N_15_0 = register_field<36, 0, 16>;
 
     enum class MASH_SEED_EN_type : register_type {
         disabled,
         enabled
     };
 
-    struct register_R37 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        register_type PFD_DLY_SEL : 6;
-        const register_type D14 : 1;
-        MASH_SEED_EN_type MASH_SEED_EN : 1;
-    };
+    using PFD_DLY_SEL = register_field<37, 8, 6>;
+    using MASH_SEED_EN = register_field<37, 15, 1, MASH_SEED_EN_type>;
 
-    struct register_R38 {
-        register_type PLL_DEN_31_16;
-    };
+    using PLL_DEN_31_16 = register_field<38, 0, 16>;
 
-    struct register_R39 {
-        register_type PLL_DEN_15_0;
-    };
+    using PLL_DEN_15_0 = register_field<39, 0, 16>;
 
-    struct register_R40 {
-        register_type MASH_SEED_31_16;
-    };
+    using MASH_SEED_31_16 = register_field<40, 0, 16>;
 
-    struct register_R41 {
-        register_type MASH_SEED_15_0;
-    };
+    using MASH_SEED_15_0 = register_field<41, 0, 16>;
 
-    struct register_R42 {
-        register_type PLL_NUM_31_16;
-    };
+    using PLL_NUM_31_16 = register_field<42, 0, 16>;
 
-    struct register_R43 {
-        register_type PLL_NUM_15_0;
-    };
+    using PLL_NUM_15_0 = register_field<43, 0, 16>;
 
     enum class MASH_ORDER_type : register_type {
         integer,
@@ -527,17 +278,11 @@ namespace lmx2594_registers {
         powerdown
     };
 
-    struct register_R44 {
-        MASH_ORDER_type MASH_ORDER : 3;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        MASH_RESET_N_type MASH_RESET_N : 1;
-        OUT_PD_type OUTA_PD : 1;
-        OUT_PD_type OUTB_PD : 1;
-        register_type OUTA_PWR : 6;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using MASH_ORDER = register_field<44, 0, 3, MASH_ORDER_type>;
+    using MASH_RESET_N = register_field<44, 5, 1, MASH_RESET_N_type>;
+    using OUTA_PD = register_field<44, 6, 1, OUT_PD_type>;
+    using OUTB_PD = register_field<44, 7, 1, OUT_PD_type>;
+    using OUTA_PWR = register_field<44, 8, 6>;
 
     enum class OUTA_MUX_type : register_type {
         chdiv,
@@ -551,17 +296,9 @@ namespace lmx2594_registers {
         boost_off
     };
 
-    struct register_R45 {
-        register_type OUTB_PWR : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        OUT_ISET_type OUT_ISET : 2;
-        OUTA_MUX_type OUTA_MUX : 2;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using OUTB_PWR = register_field<45, 0, 6>;
+    using OUT_ISET = register_field<45, 9, 2, OUT_ISET_type>;
+    using OUTA_MUX = register_field<45, 11, 2, OUTA_MUX_type>;
 
     enum class OUTB_MUX_type : register_type {
         chdiv,
@@ -570,23 +307,7 @@ namespace lmx2594_registers {
         high_z
     };
 
-    struct register_R46 {
-        OUTB_MUX_type OUTB_MUX : 2;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using OUTB_MUX = register_field<46, 0, 2, OUTB_MUX_type>;
 
     enum class INPIN_FMT_type : register_type {
         SYNC_SysRefReq_CMOS,
@@ -610,57 +331,23 @@ namespace lmx2594_registers {
         SYNC_SysRefReq_ignored
     };
 
-    struct register_R58 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        INPIN_FMT_type INPIN_FMT : 3;
-        INPIN_LVL_type INPIN_LVL : 2;
-        INPIN_HYST_type INPIN_HYST : 1;
-        INPIN_IGNORE_type INPIN_IGNORE : 1;
-    };
+    using INPIN_FMT = register_field<58, 9, 3, INPIN_FMT_type>;
+    using INPIN_LVL = register_field<58, 12, 2, INPIN_LVL_type>;
+    using INPIN_HYST = register_field<58, 14, 1, INPIN_HYST_type>;
+    using INPIN_IGNORE = register_field<58, 15, 1, INPIN_IGNORE_type>;
 
     enum class LD_TYPE_type : register_type {
         vco_status,
         vco_vtune_status
     };
 
-    struct register_R59 {
-        LD_TYPE_type LD_TYPE : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using LD_TYPE = register_field<59, 0, 1, LD_TYPE_type>;
 
-    struct register_R60 {
-        register_type LD_DLY;
-    };
+    using LD_DLY = register_field<60, 0, 16>;
 
-    struct register_R69 {
-        register_type MASH_RST_COUNT_31_16;
-    };
+    using MASH_RST_COUNT_31_16 = register_field<69, 0, 16>;
 
-    struct register_R70 {
-        register_type MASH_RST_COUNT_15_0;
-    };
+    using MASH_RST_COUNT_15_0 = register_field<70, 0, 16>;
 
     enum class SYSREF_DIV_PRE_type : register_type {
         div1 = 1,
@@ -680,22 +367,10 @@ namespace lmx2594_registers {
         enabled
     };
 
-    struct register_R71 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        SYSREF_REPEAT_type SYSREF_REPEAT : 1;
-        SYSREF_EN_type SYSREF_EN : 1;
-        SYSREF_PULSE_type SYSREF_PULSE : 1;
-        SYSREF_DIV_PRE_type SYSREF_DIV_PRE : 3;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using SYSREF_REPEAT = register_field<71, 2, 1, SYSREF_REPEAT_type>;
+    using SYSREF_EN = register_field<71, 3, 1, SYSREF_EN_type>;
+    using SYSREF_PULSE = register_field<71, 4, 1, SYSREF_PULSE_type>;
+    using SYSREF_DIV_PRE = register_field<71, 5, 3, SYSREF_DIV_PRE_type>;
 
     inline constexpr register_type get_SYSREF_DIV(const uint16_t div) noexcept
     {
@@ -712,29 +387,14 @@ namespace lmx2594_registers {
         return res;
     }
 
-    struct register_R72 {
-        register_type SYSREF_DIV : 11;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using SYSREF_DIV = register_field<72, 0, 11>;
 
-    struct register_R73 {
-        register_type JESD_DAC1_CTRL : 6;
-        register_type JESD_DAC2_CTRL : 6;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using JESD_DAC1_CTRL = register_field<73, 0, 6>;
+    using JESD_DAC2_CTRL = register_field<73, 6, 6>;
 
-    struct register_R74 {
-        register_type JESD_DAC3_CTRL : 6;
-        register_type JESD_DAC4_CTRL : 6;
-        register_type SYSREF_PULSE_CNT : 4;
-    };
+    using JESD_DAC3_CTRL = register_field<74, 0, 6>;
+    using JESD_DAC4_CTRL = register_field<74, 6, 6>;
+    using SYSREF_PULSE_CNT = register_field<74, 12, 4>;
 
     enum class CHDIV_type : register_type {
         div2,
@@ -757,111 +417,40 @@ namespace lmx2594_registers {
         div768
     };
 
-    struct register_R75 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        CHDIV_type CHDIV : 5;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using CHDIV = register_field<75, 6, 5, CHDIV_type>;
 
     enum class QUICK_RECAL_EN_type : register_type {
         disable,
         enable
     };
 
-    struct register_R78 {
-        const register_type D0 : 1;
-        register_type VCO_CAPCTRL_STRT : 8;
-        QUICK_RECAL_EN_type QUICK_RECAL_EN : 1;
-        const register_type D10 : 1;
-        register_type RAMP_THRESH_32 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using VCO_CAPCTRL_STRT = register_field<78, 1, 8>;
+    using QUICK_RECAL_EN = register_field<78, 9, 1, QUICK_RECAL_EN_type>;
+    using RAMP_THRESH_32 = register_field<78, 11, 1>;
 
-    struct register_R79 {
-        register_type RAMP_THRESH_31_16;
-    };
+    using RAMP_THRESH_31_16 = register_field<79, 0, 16>;
 
-    struct register_R80 {
-        register_type RAMP_THRESH_15_0;
-    };
+    using RAMP_THRESH_15_0 = register_field<80, 0, 16>;
 
-    struct register_R81 {
-        register_type RAMP_LIMIT_HIGH_32 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using RAMP_LIMIT_HIGH_32 = register_field<81, 0, 1>;
 
-    struct register_R82 {
-        register_type RAMP_LIMIT_HIGH_31_16;
-    };
+    using RAMP_LIMIT_HIGH_31_16 = register_field<82, 0, 16>;
 
-    struct register_R83 {
-        register_type RAMP_LIMIT_HIGH_15_0;
-    };
+    using RAMP_LIMIT_HIGH_15_0 = register_field<83, 0, 16>;
 
-    struct register_R84 {
-        register_type RAMP_LIMIT_LOW_32 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using RAMP_LIMIT_LOW_32 = register_field<84, 0, 1>;
 
-    struct register_R85 {
-        register_type RAMP_LIMIT_LOW_31_16;
-    };
+    using RAMP_LIMIT_LOW_31_16 = register_field<85, 0, 16>;
 
-    struct register_R86 {
-        register_type RAMP_LIMIT_LOW_15_0;
-    };
+    using RAMP_LIMIT_LOW_15_0 = register_field<86, 0, 16>;
 
     enum class RAMP_BURST_EN_type : register_type {
         disable,
         boost_ramping_mode_enable
     };
 
-    struct register_R96 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        register_type RAMP_BURST_COUNT : 13;
-        RAMP_BURST_EN_type RAMP_BURST_EN : 1;
-    };
+    using RAMP_BURST_COUNT = register_field<96, 2, 13>;
+    using RAMP_BURST_EN = register_field<96, 15, 1, RAMP_BURST_EN_type>;
 
     enum class RAMP_TRIG_type : register_type {
         disabled,
@@ -881,89 +470,36 @@ namespace lmx2594_registers {
         trigger_b
     };
 
-    struct register_R97 {
-        RAMP_BURST_TRIG_type RAMP_BURST_TRIG : 2;
-        const register_type D2 : 1;
-        RAMP_TRIG_type RAMP_TRIGA : 4;
-        RAMP_TRIG_type RAMP_TRIGB : 4;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        RAMP0_RST_type RAMP0_RST : 1;
-    };
+    using RAMP_BURST_TRIG = register_field<97, 0, 2, RAMP_BURST_TRIG_type>;
+    using RAMP_TRIGA = register_field<97, 3, 4, RAMP_TRIG_type>;
+    using RAMP_TRIGB = register_field<97, 7, 4, RAMP_TRIG_type>;
+    using RAMP0_RST = register_field<97, 15, 1, RAMP0_RST_type>;
 
-    struct register_R98 {
-        register_type RAMP0_DLY : 1;
-        const register_type D1 : 1;
-        register_type RAMP0_INC_29_16 : 14;
-    };
+    using RAMP0_DLY = register_field<98, 0, 1>;
+    using RAMP0_INC_29_16 = register_field<98, 2, 14>;
 
-    struct register_R99 {
-        register_type RAMP0_INC_15_0;
-    };
+    using RAMP0_INC_15_0 = register_field<99, 0, 16>;
 
-    struct register_R100 {
-        register_type RAMP0_LEN;
-    };
+    using RAMP0_LEN = register_field<100, 0, 16>;
 
-    struct register_R101 {
-        register_type RAMP0_NEXT_TRIG : 2;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        register_type RAMP0_NEXT : 1;
-        register_type RAMP1_RST : 1;
-        register_type RAMP1_DLY : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using RAMP0_NEXT_TRIG = register_field<101, 0, 2>;
+    using RAMP0_NEXT = register_field<101, 4, 1>;
+    using RAMP1_RST = register_field<101, 5, 1>;
+    using RAMP1_DLY = register_field<101, 6, 1>;
 
-    struct register_R102 {
-        register_type RAMP1_INC_29_16 : 14;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using RAMP1_INC_29_16 = register_field<102, 0, 14>;
 
-    struct register_R103 {
-        register_type RAMP1_INC_15_0;
-    };
+    using RAMP1_INC_15_0 = register_field<103, 0, 16>;
 
-    struct register_R104 {
-        register_type RAMP1_LEN;
-    };
+    using RAMP1_LEN = register_field<104, 0, 16>;
 
-    struct register_R105 {
-        register_type RAMP1_NEXT_TRIG : 2;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        register_type RAMP1_NEXT : 1;
-        register_type RAMP_MANUAL : 1;
-        register_type RAMP_DLY_CNT : 10;
-    };
+    using RAMP1_NEXT_TRIG = register_field<105, 0, 2>;
+    using RAMP1_NEXT = register_field<105, 4, 1>;
+    using RAMP_MANUAL = register_field<105, 5, 1>;
+    using RAMP_DLY_CNT = register_field<105, 6, 10>;
 
-    struct register_R106 {
-        register_type RAMP_SCALE_COUNT : 3;
-        const register_type D3 : 1;
-        register_type RAMP_TRIG_CAL : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using RAMP_SCALE_COUNT = register_field<106, 0, 3>;
+    using RAMP_TRIG_CAL = register_field<106, 4, 1>;
 
     enum class rb_VCO_SEL_type : register_type {
         invalid,
@@ -983,163 +519,15 @@ namespace lmx2594_registers {
         vtune_high
     };
 
-    struct register_R110 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        rb_VCO_SEL_type rb_VCO_SEL : 3;
-        const register_type D8 : 1;
-        rb_LD_VTUNE_type rb_LD_VTUNE : 2;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using rb_VCO_SEL = register_field<110, 5, 3, rb_VCO_SEL_type>;
+    using rb_LD_VTUNE = register_field<110, 9, 2, rb_LD_VTUNE_type>;
 
-    struct register_R111 {
-        register_type rb_VCO_CAPCTRL : 8;
-        const register_type D8 : 1;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using rb_VCO_CAPCTRL = register_field<111, 0, 8>;
 
-    struct register_R112 {
-        register_type rb_VCO_DACISET : 9;
-        const register_type D9 : 1;
-        const register_type D10 : 1;
-        const register_type D11 : 1;
-        const register_type D12 : 1;
-        const register_type D13 : 1;
-        const register_type D14 : 1;
-        const register_type D15 : 1;
-    };
+    using rb_VCO_DACISET = register_field<112, 0, 9>;
 
     namespace detail {
 
-        struct registers_map {
-            register_basic<register_R0> reg_R0 {};
-            register_basic<register_R1> reg_R1 {};
-            register_basic<register_common> reg_R2 {};
-            register_basic<register_common> reg_R3 {};
-            register_basic<register_R4> reg_R4 {};
-            register_basic<register_common> reg_R5 {};
-            register_basic<register_common> reg_R6 {};
-            register_basic<register_R7> reg_R7 {};
-            register_basic<register_R8> reg_R8 {};
-            register_basic<register_R9> reg_R9 {};
-            register_basic<register_R10> reg_R10 {};
-            register_basic<register_R11> reg_R11 {};
-            register_basic<register_R12> reg_R12 {};
-            register_basic<register_common> reg_R13 {};
-            register_basic<register_R14> reg_R14 {};
-            register_basic<register_common> reg_R15 {};
-            register_basic<register_R16> reg_R16 {};
-            register_basic<register_R17> reg_R17 {};
-            register_basic<register_common> reg_R18 {};
-            register_basic<register_R19> reg_R19 {};
-            register_basic<register_R20> reg_R20 {};
-            register_basic<register_common> reg_R21 {};
-            register_basic<register_common> reg_R22 {};
-            register_basic<register_common> reg_R23 {};
-            register_basic<register_common> reg_R24 {};
-            register_basic<register_common> reg_R25 {};
-            register_basic<register_common> reg_R26 {};
-            register_basic<register_common> reg_R27 {};
-            register_basic<register_common> reg_R28 {};
-            register_basic<register_common> reg_R29 {};
-            register_basic<register_common> reg_R30 {};
-            register_basic<register_R31> reg_R31 {};
-            register_basic<register_common> reg_R32 {};
-            register_basic<register_common> reg_R33 {};
-            register_basic<register_R34> reg_R34 {};
-            register_basic<register_common> reg_R35 {};
-            register_basic<register_R36> reg_R36 {};
-            register_basic<register_R37> reg_R37 {};
-            register_basic<register_R38> reg_R38 {};
-            register_basic<register_R39> reg_R39 {};
-            register_basic<register_R40> reg_R40 {};
-            register_basic<register_R41> reg_R41 {};
-            register_basic<register_R42> reg_R42 {};
-            register_basic<register_R43> reg_R43 {};
-            register_basic<register_R44> reg_R44 {};
-            register_basic<register_R45> reg_R45 {};
-            register_basic<register_R46> reg_R46 {};
-            register_basic<register_common> reg_R47 {};
-            register_basic<register_common> reg_R48 {};
-            register_basic<register_common> reg_R49 {};
-            register_basic<register_common> reg_R50 {};
-            register_basic<register_common> reg_R51 {};
-            register_basic<register_common> reg_R52 {};
-            register_basic<register_common> reg_R53 {};
-            register_basic<register_common> reg_R54 {};
-            register_basic<register_common> reg_R55 {};
-            register_basic<register_common> reg_R56 {};
-            register_basic<register_common> reg_R57 {};
-            register_basic<register_R58> reg_R58 {};
-            register_basic<register_R59> reg_R59 {};
-            register_basic<register_R60> reg_R60 {};
-            register_basic<register_common> reg_R61 {};
-            register_basic<register_common> reg_R62 {};
-            register_basic<register_common> reg_R63 {};
-            register_basic<register_common> reg_R64 {};
-            register_basic<register_common> reg_R65 {};
-            register_basic<register_common> reg_R66 {};
-            register_basic<register_common> reg_R67 {};
-            register_basic<register_common> reg_R68 {};
-            register_basic<register_R69> reg_R69 {};
-            register_basic<register_R70> reg_R70 {};
-            register_basic<register_R71> reg_R71 {};
-            register_basic<register_R72> reg_R72 {};
-            register_basic<register_R73> reg_R73 {};
-            register_basic<register_R74> reg_R74 {};
-            register_basic<register_R75> reg_R75 {};
-            register_basic<register_common> reg_R76 {};
-            register_basic<register_common> reg_R77 {};
-            register_basic<register_R78> reg_R78 {};
-            register_basic<register_R79> reg_R79 {};
-            register_basic<register_R80> reg_R80 {};
-            register_basic<register_R81> reg_R81 {};
-            register_basic<register_R82> reg_R82 {};
-            register_basic<register_R83> reg_R83 {};
-            register_basic<register_R84> reg_R84 {};
-            register_basic<register_R85> reg_R85 {};
-            register_basic<register_R86> reg_R86 {};
-            register_basic<register_common> reg_R87 {};
-            register_basic<register_common> reg_R88 {};
-            register_basic<register_common> reg_R89 {};
-            register_basic<register_common> reg_R90 {};
-            register_basic<register_common> reg_R91 {};
-            register_basic<register_common> reg_R92 {};
-            register_basic<register_common> reg_R93 {};
-            register_basic<register_common> reg_R94 {};
-            register_basic<register_common> reg_R95 {};
-            register_basic<register_R96> reg_R96 {};
-            register_basic<register_R97> reg_R97 {};
-            register_basic<register_R98> reg_R98 {};
-            register_basic<register_R99> reg_R99 {};
-            register_basic<register_R100> reg_R100 {};
-            register_basic<register_R101> reg_R101 {};
-            register_basic<register_R102> reg_R102 {};
-            register_basic<register_R103> reg_R103 {};
-            register_basic<register_R104> reg_R104 {};
-            register_basic<register_R105> reg_R105 {};
-            register_basic<register_R106> reg_R106 {};
-            register_basic<register_common> reg_R107 {};
-            register_basic<register_common> reg_R108 {};
-            register_basic<register_common> reg_R109 {};
-            register_basic<register_R110> reg_R110 {};
-            register_basic<register_R111> reg_R111 {};
-            register_basic<register_R112> reg_R112 {};
-        };
-
         struct registers_range {
             int begin {};
             int end {};
@@ -1147,183 +535,63 @@ namespace lmx2594_registers {
 
     } // namespace detail
 
-    const int register_max_num { sizeof(detail::registers_map) / sizeof(register_type) };
+    const int register_max_num { 113 };
     const detail::registers_range registers_range_common { 0, 78 };
     const detail::registers_range registers_range_ramping { 79, 106 };
     const detail::registers_range registers_range_readback { 107, 112 };
 
-    namespace detail {
-
-        union { // SNAS696C-MARCH 2017 - REVISED APRIL 2019
-            const registers_map regs {
-                .reg_R0 { .bits {
-                    .POWERDOWN = POWERDOWN_type::normal,
-                    .RESET = RESET_type::normal,
-                    .MUXOUT_LD_SEL = MUXOUT_LD_SEL_type::readback,
-                    .FCAL_EN = FCAL_EN_type::disabled,
-                    .D4 = 1,
-                    .FCAL_LPFD_ADJ = FCAL_LPFD_ADJ_type::upper_10_MHz,
-                    .FCAL_HPFD_ADJ = FCAL_HPFD_ADJ_type::lower_100_MHz,
-                    .OUT_MUTE = OUT_MUTE_type::disabled,
-                    .D10 = 1,
-                    .D13 = 1,
-                    .VCO_PHASE_SYNC = VCO_PHASE_SYNC_type::disabled,
-                    .RAMP_EN = RAMP_EN_type::disabled } },
-                .reg_R1 { .bits { .CAL_CLK_DIV = CAL_CLK_DIV_type::div8, .D3 = 1, .D11 = 1 } },
-                .reg_R2 { .bits { .D8 = 1, .D10 = 1 } },
-                .reg_R3 { .bits { .D1 = 1, .D6 = 1, .D9 = 1, .D10 = 1 } },
-                .reg_R4 { .bits { .D0 = 1, .D1 = 1, .D6 = 1, .ACAL_CMP_DLY = 10 } },
-                .reg_R5 { .bits { .D3 = 1, .D6 = 1, .D7 = 1 } },
-                .reg_R6 { .bits { .D1 = 1, .D11 = 1, .D14 = 1, .D15 = 1 } },
-                .reg_R7 { .bits { .D1 = 1, .D4 = 1, .D5 = 1, .D7 = 1, .OUT_FORCE = OUT_FORCE_type::disabled } },
-                .reg_R8 { .bits {
-                    .VCO_CAPCTRL_FORCE = VCO_CAPCTRL_FORCE_type::disabled,
-                    .D13 = 1,
-                    .VCO_DACISET_FORCE = VCO_DACISET_FORCE_type::disabled } },
-                .reg_R9 { .bits { .D2 = 1, .D9 = 1, .D10 = 1, .OSC_2X = OSC_2X_type::disabled } },
-                .reg_R10 { .bits { .D3 = 1, .D4 = 1, .D6 = 1, .MULT = MULT_type::bypass, .D12 = 1 } },
-                .reg_R11 { .bits { .D3 = 1, .PLL_R = 1 } },
-                .reg_R12 { .bits { .PLL_R_PRE = 1, .D12 = 1, .D14 = 1 } },
-                .reg_R13 { .bits { .D14 = 1 } },
-                .reg_R14 { .bits { .CPG = CPG_type::current_15_mA, .D9 = 1, .D10 = 1, .D11 = 1, .D12 = 1 } },
-                .reg_R15 { .bits { .D0 = 1, .D1 = 1, .D2 = 1, .D3 = 1, .D6 = 1, .D9 = 1, .D10 = 1 } },
-                .reg_R16 { .bits { .VCO_DACISET = 128 } },
-                .reg_R17 { .bits { .VCO_DACISET_STRT = 250 } },
-                .reg_R18 { .bits { .D2 = 1, .D5 = 1, .D6 = 1 } },
-                .reg_R19 { .bits { .VCO_CAPCTRL = 183, .D8 = 1, .D9 = 1, .D10 = 1, .D13 = 1 } },
-                .reg_R20 { .bits { .D3 = 1,
-                    .D6 = 1,
-                    .VCO_SEL_FORCE = VCO_SEL_FORCE_type::disabled,
-                    .VCO_SEL = VCO_SEL_type::vco7,
-                    .D14 = 1,
-                    .D15 = 1 } },
-                .reg_R21 { .bits { .D0 = 1, .D10 = 1 } },
-                .reg_R22 { .bits { .D0 = 1 } },
-                .reg_R23 { .bits { .D2 = 1, .D3 = 1, .D4 = 1, .D5 = 1, .D6 = 1 } },
-                .reg_R24 { .bits { .D1 = 1, .D3 = 1, .D4 = 1, .D8 = 1, .D9 = 1, .D10 = 1 } },
-                .reg_R25 { .bits { .D0 = 1, .D1 = 1, .D3 = 1, .D5 = 1, .D10 = 1, .D11 = 1 } },
-                .reg_R26 { .bits { .D4 = 1, .D5 = 1, .D7 = 1, .D8 = 1, .D10 = 1, .D11 = 1 } },
-                .reg_R27 { .bits { .D1 = 1 } },
-                .reg_R28 { .bits { .D3 = 1, .D7 = 1, .D10 = 1 } },
-                .reg_R29 { .bits { .D2 = 1, .D3 = 1, .D7 = 1, .D8 = 1, .D12 = 1, .D13 = 1 } },
-                .reg_R30 { .bits { .D2 = 1, .D3 = 1, .D7 = 1, .D8 = 1, .D12 = 1, .D13 = 1 } },
-                .reg_R31 { .bits { .D2 = 1, .D3 = 1, .D5 = 1, .D6 = 1, .D7 = 1, .D8 = 1, .D9 = 1, .SEG1_EN = SEG1_EN_type::disabled } },
-                .reg_R32 { .bits { .D0 = 1, .D1 = 1, .D4 = 1, .D7 = 1, .D8 = 1, .D9 = 1 } },
-                .reg_R33 { .bits { .D0 = 1, .D5 = 1, .D9 = 1, .D10 = 1, .D11 = 1, .D12 = 1 } },
-                .reg_R34 { .reg {} },
-                .reg_R35 { .bits { .D2 = 1 } },
-                .reg_R36 { .bits { .PLL_N_15_0 = 100 } },
-                .reg_R37 { .bits { .D2 = 1, .PFD_DLY_SEL = 2, .MASH_SEED_EN = MASH_SEED_EN_type::disabled } },
-                .reg_R38 { .reg {} },
-                .reg_R39 { .reg {} },
-                .reg_R40 { .reg {} },
-                .reg_R41 { .reg {} },
-                .reg_R42 { .reg {} },
-                .reg_R43 { .reg {} },
-                .reg_R44 { .bits {
-                    .MASH_ORDER = MASH_ORDER_type::integer,
-                    .MASH_RESET_N = MASH_RESET_N_type::frac_mode_enabled,
-                    .OUTA_PD = OUT_PD_type::active,
-                    .OUTB_PD = OUT_PD_type::powerdown,
-                    .OUTA_PWR = 31 } },
-                .reg_R45 { .bits { .D6 = 1, .D7 = 1, .OUT_ISET = OUT_ISET_type::boost_max, .OUTA_MUX = OUTA_MUX_type::vco, .D14 = 1, .D15 = 1 } },
-                .reg_R46 { .bits {
-                    .OUTB_MUX = OUTB_MUX_type::vco, .D2 = 1, .D3 = 1, .D4 = 1, .D5 = 1, .D6 = 1, .D7 = 1, .D8 = 1, .D9 = 1, .D10 = 1 } },
-                .reg_R47 { .bits { .D8 = 1, .D9 = 1 } },
-                .reg_R48 { .bits { .D8 = 1, .D9 = 1 } },
-                .reg_R49 { .bits { .D7 = 1, .D8 = 1, .D14 = 1 } },
-                .reg_R50 { .reg {} },
-                .reg_R51 { .bits { .D7 = 1 } },
-                .reg_R52 { .bits { .D5 = 1, .D11 = 1 } },
-                .reg_R53 { .reg {} },
-                .reg_R54 { .reg {} },
-                .reg_R55 { .reg {} },
-                .reg_R56 { .reg {} },
-                .reg_R57 { .bits { .D5 = 1 } },
-                .reg_R58 { .bits {
-                    .D0 = 1,
-                    .INPIN_FMT = INPIN_FMT_type::SYNC_SysRefReq_CMOS,
-                    .INPIN_LVL = INPIN_LVL_type::div4,
-                    .INPIN_HYST = INPIN_HYST_type::disabled,
-                    .INPIN_IGNORE = INPIN_IGNORE_type::SYNC_SysRefReq_ignored } },
-                .reg_R59 { .bits { .LD_TYPE = LD_TYPE_type::vco_vtune_status } },
-                .reg_R60 { .reg {} },
-                .reg_R61 { .bits { .D3 = 1, .D5 = 1, .D7 = 1 } },
-                .reg_R62 { .bits { .D1 = 1, .D5 = 1, .D8 = 1, .D9 = 1 } },
-                .reg_R63 { .reg {} },
-                .reg_R64 { .bits { .D3 = 1, .D7 = 1, .D8 = 1, .D9 = 1, .D12 = 1 } },
-                .reg_R65 { .reg {} },
-                .reg_R66 { .bits { .D2 = 1, .D4 = 1, .D5 = 1, .D6 = 1, .D7 = 1, .D8 = 1 } },
-                .reg_R67 { .reg {} },
-                .reg_R68 { .bits { .D3 = 1, .D5 = 1, .D6 = 1, .D7 = 1, .D8 = 1, .D9 = 1 } },
-                .reg_R69 { .reg {} },
-                .reg_R70 { .reg {} },
-                .reg_R71 { .bits {
-                    .D0 = 1,
-                    .SYSREF_REPEAT = SYSREF_REPEAT_type::master_mode,
-                    .SYSREF_EN = SYSREF_EN_type::disabled,
-                    .SYSREF_PULSE = SYSREF_PULSE_type::disabled,
-                    .SYSREF_DIV_PRE = SYSREF_DIV_PRE_type::div4 } },
-                .reg_R72 { .bits { .SYSREF_DIV = get_SYSREF_DIV(4) } },
-                .reg_R73 { .bits { .JESD_DAC1_CTRL = 63 } },
-                .reg_R74 { .reg {} },
-                .reg_R75 { .bits { .CHDIV = CHDIV_type::div2, .D11 = 1 } },
-                .reg_R76 { .bits { .D2 = 1, .D3 = 1 } },
-                .reg_R77 { .reg {} },
-                .reg_R78 { .bits { .D0 = 1, .QUICK_RECAL_EN = QUICK_RECAL_EN_type::disable } },
-                .reg_R79 { .reg {} },
-                .reg_R80 { .reg {} },
-                .reg_R81 { .reg {} },
-                .reg_R82 { .reg {} },
-                .reg_R83 { .reg {} },
-                .reg_R84 { .reg {} },
-                .reg_R85 { .reg {} },
-                .reg_R86 { .reg {} },
-                .reg_R87 { .reg {} },
-                .reg_R88 { .reg {} },
-                .reg_R89 { .reg {} },
-                .reg_R90 { .reg {} },
-                .reg_R91 { .reg {} },
-                .reg_R92 { .reg {} },
-                .reg_R93 { .reg {} },
-                .reg_R94 { .reg {} },
-                .reg_R95 { .reg {} },
-                .reg_R96 { .bits { .RAMP_BURST_EN = RAMP_BURST_EN_type::disable } },
-                .reg_R97 { .bits {
-                    .RAMP_BURST_TRIG = RAMP_BURST_TRIG_type::ramp_transition,
-                    .RAMP_TRIGA = RAMP_TRIG_type::disabled,
-                    .RAMP_TRIGB = RAMP_TRIG_type::disabled,
-                    .D11 = 1,
-                    .RAMP0_RST = RAMP0_RST_type::disabled } },
-                .reg_R98 { .reg {} },
-                .reg_R99 { .reg {} },
-                .reg_R100 { .reg {} },
-                .reg_R101 { .reg {} },
-                .reg_R102 { .reg {} },
-                .reg_R103 { .reg {} },
-                .reg_R104 { .reg {} },
-                .reg_R105 { .reg {} },
-                .reg_R106 { .reg {} },
-                .reg_R107 { .reg {} },
-                .reg_R108 { .reg {} },
-                .reg_R109 { .reg {} },
-                .reg_R110 { .reg {} },
-                .reg_R111 { .reg {} },
-                .reg_R112 { .reg {} }
-            };
-            const register_type array[register_max_num];
-        } const registers_map_defaults {};
-
-    } // namespace detail
-
-    union registers_map {
-        detail::registers_map regs { detail::registers_map_defaults.regs };
-        register_type array[register_max_num];
-    };
+    // SNAS696C-MARCH 2017 - REVISED APRIL 2019. R0 and the readback registers
+    // are volatile: writing R0 can start a calibration.
+    using registers_table = register_table<register_type, register_max_num,
+        register_def<0, 0x2410, true>, register_def<1, 0x080B>, register_def<2, 0x0500>, register_def<3, 0x0642>,
+        register_def<4, 0x0A43>, register_def<5, 0x00C8>, register_def<6, 0xC802>, register_def<7, 0x00B2>,
+        register_def<8, 0x2000>, register_def<9, 0x0604>, register_def<10, 0x10D8>, register_def<11, 0x0018>,
+        register_def<12, 0x5001>, register_def<13, 0x4000>, register_def<14, 0x1E70>, register_def<15, 0x064F>,
+        register_def<16, 0x0080>, register_def<17, 0x00FA>, register_def<18, 0x0064>, register_def<19, 0x27B7>,
+        register_def<20, 0xF848>, register_def<21, 0x0401>, register_def<22, 0x0001>, register_def<23, 0x007C>,
+        register_def<24, 0x071A>, register_def<25, 0x0C2B>, register_def<26, 0x0DB0>, register_def<27, 0x0002>,
+        register_def<28, 0x0488>, register_def<29, 0x318C>, register_def<30, 0x318C>, register_def<31, 0x03EC>,
+        register_def<32, 0x0393>, register_def<33, 0x1E21>, register_def<34, 0x0000>, register_def<35, 0x0004>,
+        register_def<36, 0x0064>, register_def<37, 0x0204>, register_def<38, 0x0000>, register_def<39, 0x0000>,
+        register_def<40, 0x0000>, register_def<41, 0x0000>, register_def<42, 0x0000>, register_def<43, 0x0000>,
+        register_def<44, 0x1FA0>, register_def<45, 0xC8C0>, register_def<46, 0x07FD>, register_def<47, 0x0300>,
+        register_def<48, 0x0300>, register_def<49, 0x4180>, register_def<50, 0x0000>, register_def<51, 0x0080>,
+        register_def<52, 0x0820>, register_def<53, 0x0000>, register_def<54, 0x0000>, register_def<55, 0x0000>,
+        register_def<56, 0x0000>, register_def<57, 0x0020>, register_def<58, 0x8001>, register_def<59, 0x0001>,
+        register_def<60, 0x0000>, register_def<61, 0x00A8>, register_def<62, 0x0322>, register_def<63, 0x0000>,
+        register_def<64, 0x1388>, register_def<65, 0x0000>, register_def<66, 0x01F4>, register_def<67, 0x0000>,
+        register_def<68, 0x03E8>, register_def<69, 0x0000>, register_def<70, 0x0000>, register_def<71, 0x0081>,
+        register_def<72, 0x0000>, register_def<73, 0x003F>, register_def<74, 0x0000>, register_def<75, 0x0800>,
+        register_def<76, 0x000C>, register_def<77, 0x0000>, register_def<78, 0x0001>, register_def<79, 0x0000>,
+        register_def<80, 0x0000>, register_def<81, 0x0000>, register_def<82, 0x0000>, register_def<83, 0x0000>,
+        register_def<84, 0x0000>, register_def<85, 0x0000>, register_def<86, 0x0000>, register_def<87, 0x0000>,
+        register_def<88, 0x0000>, register_def<89, 0x0000>, register_def<90, 0x0000>, register_def<91, 0x0000>,
+        register_def<92, 0x0000>, register_def<93, 0x0000>, register_def<94, 0x0000>, register_def<95, 0x0000>,
+        register_def<96, 0x0000>, register_def<97, 0x0800>, register_def<98, 0x0000>, register_def<99, 0x0000>,
+        register_def<100, 0x0000>, register_def<101, 0x0000>, register_def<102, 0x0000>, register_def<103, 0x0000>,
+        register_def<104, 0x0000>, register_def<105, 0x0000>, register_def<106, 0x0000>, register_def<107, 0x0000>,
+        register_def<108, 0x0000>, register_def<109, 0x0000>, register_def<110, 0x0000, true>, register_def<111, 0x0000, true>,
+        register_def<112, 0x0000, true>>;
+    using registers_map = registers_table::registers_map;
+
+    constexpr registers_map registers_map_defaults { registers_table::get_defaults() };
 
     using registers_update = ::chappi::registers_update<lmx2594_registers::register_max_num>;
+    using registers_diff = ::chappi::registers_diff<register_type, register_max_num>;
+    using register_dump = ::chappi::register_dump<register_type, register_max_num>;
 
-#pragma pack(pop)
+    // Readback registers are never written. R0 goes last and with any other
+    // change, so the FCAL_EN it carries calibrates the VCO for the new values.
+    inline const registers_diff& get_registers_diff()
+    {
+        static const registers_diff diff = [] {
+            registers_diff rules {};
+            rules.set_readonly(registers_range_readback.begin, registers_range_readback.end);
+            rules.set_last(0, true);
+            return rules;
+        }();
+        return diff;
+    }
 
 } // namespace lmx2594_registers
 
@@ -1369,23 +637,29 @@ namespace detail {
 } // namespace detail
 
 template <typename ErrorType = int, ErrorType NoerrorValue = 0,
-    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint16_t>
-class lmx2594 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint16_t, typename IoPolicy = dynamic_io>
+class lmx2594 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy> {
     static constexpr auto _chip_name = "LMX2594";
     detail::lmx2594_counter _counter;
-    mutable lmx2594_registers::registers_map _registers_map {};
+    mutable lmx2594_registers::registers_map _registers_map { lmx2594_registers::registers_map_defaults };
     mutable lmx2594_registers::registers_update _registers_update {};
-    mutable bool _is_integer_mode {};
+    mutable std::atomic<bool> _is_integer_mode {};
+    // Guards the shadow map and the dirty set when CHAPPI_THREAD_SAFE is
+    // defined. Held by every method that touches them while it computes and
+    // writes its registers, released before delays and lock detect polling.
+    mutable detail::driver_mutex _mutex {};
 
 public:
     CHIP_BASE_RESOLVE
+    using registers_table = lmx2594_registers::registers_table;
     lmx2594(bool log_enable)
         : lmx2594 { (log_enable) ? std::clog.rdbuf() : nullptr }
     {
     }
     lmx2594(std::streambuf* buf_ptr = {}, reg_read_fn reg_read = {}, reg_write_fn reg_write = {}, dev_addr_type dev_addr = {})
-        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type> { buf_ptr, reg_read, reg_write, dev_addr }
+        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type, IoPolicy> { buf_ptr, reg_read, reg_write, dev_addr }
     {
+        set_name(_chip_name, get_num());
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
@@ -1398,60 +672,172 @@ public:
     }
     int get_num() const noexcept final { return _counter.get_num(); }
     int get_counts() const noexcept final { return _counter.get_counts(); }
-    std::string get_name() const noexcept final { return get_name(_chip_name, get_num()); }
+    std::string get_name() const noexcept final { return get_name_cstr(); }
+    void setup_cache(cache_mode mode)
+    {
+        this->template setup_cache<registers_table>(mode);
+    }
     void update_changes() const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         using namespace lmx2594_registers;
-        while (_registers_update.is_changed()) {
-            const auto registers_num = _registers_update.get_changed();
-            write(registers_num, _registers_map.array[registers_num]);
-            _registers_update.clear_changed(registers_num);
-        };
+        std::array<reg_data_type, register_max_num> changes {};
+        std::size_t changes_num {};
+        // Each changed register once, from the highest down to R0. The set
+        // is only cleared once the batch is written, so a failed update
+        // leaves the changes pending.
+        auto pending = _registers_update;
+        for (auto registers_num = pending.get_changed(); registers_num < std::size_t(register_max_num);
+             registers_num = pending.get_changed()) {
+            changes[changes_num++] = { addr_type(registers_num), _registers_map.array[registers_num] };
+            pending.clear_changed(registers_num);
+        }
+        write_batch(changes.data(), changes_num);
+        if (error_raised()) {
+            return;
+        }
+        _registers_update = pending;
     }
     void reset() const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
-        using namespace lmx2594_registers;
-        _registers_map.regs.reg_R0.bits.RESET = RESET_type::reset;
-        write(0, _registers_map.regs.reg_R0.reg);
-        _registers_map.regs.reg_R0.bits.RESET = RESET_type::normal;
-        write(0, _registers_map.regs.reg_R0.reg);
-        auto register_count { register_max_num - 1 };
-        do {
-            write(register_count, _registers_map.array[register_count]);
-        } while (register_count--);
+        CHAPPI_TRACE_SPAN(__func__);
+        {
+            detail::driver_lock lock { _mutex };
+            using namespace lmx2594_registers;
+            // The reset pulse, then every register from the highest down to R0.
+            std::array<reg_data_type, register_max_num + 2> sequence {};
+            _registers_map.set<RESET>(RESET_type::reset);
+            sequence[0] = { 0, _registers_map.array[0] };
+            _registers_map.set<RESET>(RESET_type::normal);
+            sequence[1] = { 0, _registers_map.array[0] };
+            std::size_t pos { 2 };
+            for (auto register_num = register_max_num - 1; register_num >= 0; --register_num) {
+                sequence[pos++] = { addr_type(register_num), _registers_map.array[register_num] };
+            }
+            write_batch(sequence.data(), sequence.size());
+        }
+        if (error_raised()) {
+            return;
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
     void reset(error_type& error) const noexcept
     {
         helpers::noexcept_void_function<lmx2594, error_type, NoerrorValue, &lmx2594::reset>(this, error);
     }
+    void get_registers_map(lmx2594_registers::registers_map& registers_map) const
+    {
+#if defined(CHAPPI_LOG_ENABLE)
+        log_info(__func__);
+#endif
+        detail::driver_lock lock { _mutex };
+        registers_map = _registers_map;
+    }
+    lmx2594_registers::registers_map get_registers_map() const
+    {
+        lmx2594_registers::registers_map registers_map {};
+        get_registers_map(registers_map);
+        return registers_map;
+    }
+    // Switches to another full register image, a profile saved with
+    // get_registers_map(), writing only the registers that differ from the
+    // shadow map or are still pending, then R0 with a VCO calibration.
+    void update_registers_map(const lmx2594_registers::registers_map& registers_map) const
+    {
+#if defined(CHAPPI_LOG_ENABLE)
+        log_info(__func__);
+#endif
+        CHAPPI_TRACE_SPAN(__func__);
+        detail::driver_lock lock { _mutex };
+        using namespace lmx2594_registers;
+        auto current = _registers_map;
+        auto target = registers_map;
+        current.set<FCAL_EN>(FCAL_EN_type::calibrate_vco);
+        target.set<FCAL_EN>(FCAL_EN_type::calibrate_vco);
+        std::array<reg_data_type, register_max_num> writes {};
+        const auto writes_num = get_registers_diff().get_writes(current, target, writes.data(), _registers_update);
+        write_batch(writes.data(), writes_num);
+        if (error_raised()) {
+            return;
+        }
+        _registers_map = registers_map;
+        _registers_map.set<FCAL_EN>(FCAL_EN_type::disabled);
+        _registers_update = {};
+        _is_integer_mode = (_registers_map.get<MASH_ORDER>() == MASH_ORDER_type::integer);
+    }
+    void update_registers_map(const lmx2594_registers::registers_map& registers_map, error_type& error) const noexcept
+    {
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_registers_map(registers_map); });
+    }
+    // Loads the registers marked in registers, a profile of a vendor dump,
+    // into the shadow map and writes them with any pending changes in one
+    // batch, R0 last with a VCO calibration. Readback registers in the dump
+    // are ignored.
+    void update_registers_map(const lmx2594_registers::registers_map& registers_map,
+        const lmx2594_registers::registers_update& registers) const
+    {
+#if defined(CHAPPI_LOG_ENABLE)
+        log_info(__func__);
+#endif
+        CHAPPI_TRACE_SPAN(__func__);
+        detail::driver_lock lock { _mutex };
+        using namespace lmx2594_registers;
+        for (int register_num {}; register_num < registers_range_readback.begin; ++register_num) {
+            if (registers.is_changed(std::size_t(register_num))) {
+                _registers_map.array[register_num] = registers_map.array[register_num];
+                _registers_update.set_changed(register_num);
+            }
+        }
+        std::array<reg_data_type, register_max_num> writes {};
+        _registers_map.set<FCAL_EN>(FCAL_EN_type::calibrate_vco);
+        const auto writes_num = get_registers_diff().get_writes(_registers_map, _registers_map, writes.data(), _registers_update);
+        _registers_map.set<FCAL_EN>(FCAL_EN_type::disabled);
+        write_batch(writes.data(), writes_num);
+        if (error_raised()) {
+            return;
+        }
+        _registers_update = {};
+        _is_integer_mode = (_registers_map.get<MASH_ORDER>() == MASH_ORDER_type::integer);
+    }
+    void update_registers_map(const lmx2594_registers::registers_map& registers_map,
+        const lmx2594_registers::registers_update& registers, error_type& error) const noexcept
+    {
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_registers_map(registers_map, registers); });
+    }
     void chip_enable(bool enabled) const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R0.bits.POWERDOWN = (enabled) ? POWERDOWN_type::normal : POWERDOWN_type::powerdown;
-        write(0, _registers_map.regs.reg_R0.reg);
+        _registers_map.set<POWERDOWN>((enabled) ? POWERDOWN_type::normal : POWERDOWN_type::powerdown);
+        write(0, _registers_map.array[0]);
     }
     void chip_enable(bool enabled, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::chip_enable>(this, enabled, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { chip_enable(enabled); });
     }
     void is_enabled(bool& enabled) const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         using namespace lmx2594_registers;
-        read(0, _registers_map.regs.reg_R0.reg);
-        enabled = (_registers_map.regs.reg_R0.bits.POWERDOWN == POWERDOWN_type::normal) ? true : false;
+        register_type value {};
+        read(0, value);
+        if (error_raised()) {
+            return;
+        }
+        _registers_map.array[0] = value;
+        enabled = (_registers_map.get<POWERDOWN>() == POWERDOWN_type::normal) ? true : false;
     }
     bool is_enabled() const
     {
@@ -1485,13 +871,14 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        CHAPPI_TRACE_SPAN(__func__);
         using namespace lmx2594_registers;
         const int timeout_us { 50 * 1000 };
         const int cycle_us { 10 };
         auto cycles = timeout_us / cycle_us;
         do {
             locked = _is_locked();
-            if (locked) {
+            if (locked || error_raised()) {
                 break;
             }
             std::this_thread::sleep_for(std::chrono::microseconds(cycle_us));
@@ -1512,6 +899,7 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_output_enabled(data);
         _registers_update.set_changed(44);
     }
@@ -1520,24 +908,31 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_output_enabled(data);
         _update_registers(44);
     }
     void update_output_enabled(const lmx2594_output_enable& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_output_enabled>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_output_enabled(data); });
     }
     void is_output_enabled(lmx2594_output_enable& data) const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         using namespace lmx2594_registers;
-        read(44, _registers_map.regs.reg_R44.reg);
+        register_type value {};
+        read(44, value);
+        if (error_raised()) {
+            return;
+        }
+        _registers_map.array[44] = value;
         if (data.output == lmx2594_output::outa) {
-            data.enabled = (_registers_map.regs.reg_R44.bits.OUTA_PD == OUT_PD_type::active) ? true : false;
+            data.enabled = (_registers_map.get<OUTA_PD>() == OUT_PD_type::active) ? true : false;
         } else if (data.output == lmx2594_output::outb) {
-            data.enabled = (_registers_map.regs.reg_R44.bits.OUTB_PD == OUT_PD_type::active) ? true : false;
+            data.enabled = (_registers_map.get<OUTB_PD>() == OUT_PD_type::active) ? true : false;
         }
     }
     bool is_output_enabled(lmx2594_output output) const
@@ -1551,7 +946,7 @@ public:
     {
         lmx2594_output_enable data {};
         data.output = output;
-        helpers::noexcept_get_function<lmx2594, error_type, NoerrorValue, lmx2594_output, &lmx2594::is_output_enabled>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { is_output_enabled(data); });
         return data.enabled;
     }
     void set_output_power(const lmx2594_output_power& data) const noexcept
@@ -1559,6 +954,7 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_output_power(data);
         _registers_update.set_changed(45, 44);
     }
@@ -1567,18 +963,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_output_power(data);
         _update_registers(45, 44);
     }
     void update_output_power(const lmx2594_output_power& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_output_power>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_output_power(data); });
     }
     void set_output_mux(const lmx2594_output_a_mux& value) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_output_mux(value);
         _registers_update.set_changed(45);
     }
@@ -1587,18 +985,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_output_mux(value);
         _update_registers(45);
     }
     void update_output_mux(const lmx2594_output_a_mux& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_output_mux>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_output_mux(value); });
     }
     void set_output_mux(const lmx2594_output_b_mux& value) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_output_mux(value);
         _registers_update.set_changed(46);
     }
@@ -1607,18 +1007,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_output_mux(value);
         _update_registers(46);
     }
     void update_output_mux(const lmx2594_output_b_mux& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_output_mux>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_output_mux(value); });
     }
     void set_channel_divider(const lmx2594_channel_divider& value) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_channel_divider(value);
         _registers_update.set_changed(75, 31);
     }
@@ -1627,18 +1029,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_channel_divider(value);
         _update_registers(75, 31);
     }
     void update_channel_divider(const lmx2594_channel_divider& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_channel_divider>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_channel_divider(value); });
     }
     void set_charge_pump_gain(const lmx2594_charge_pump_gain& value) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_charge_pump_gain(value);
         _registers_update.set_changed(14);
     }
@@ -1647,18 +1051,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_charge_pump_gain(value);
         _update_registers(14);
     }
     void update_charge_pump_gain(const lmx2594_charge_pump_gain& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_charge_pump_gain>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_charge_pump_gain(value); });
     }
     void set_doubler(const lmx2594_doubler& value) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_doubler(value);
         _registers_update.set_changed(9);
     }
@@ -1667,18 +1073,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_doubler(value);
         _update_registers(9);
     }
     void update_doubler(const lmx2594_doubler& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_doubler>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_doubler(value); });
     }
     void set_pre_divider(const lmx2594_pre_divider& value) const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_pre_divider(value);
         _registers_update.set_changed(12);
     }
@@ -1687,18 +1095,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_pre_divider(value);
         _update_registers(12);
     }
     void update_pre_divider(const lmx2594_pre_divider& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_pre_divider>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_pre_divider(value); });
     }
     void set_multiplier(const lmx2594_multiplier& value) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_multiplier(value);
         _registers_update.set_changed(10);
     }
@@ -1707,18 +1117,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_multiplier(value);
         _update_registers(10);
     }
     void update_multiplier(const lmx2594_multiplier& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_multiplier>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_multiplier(value); });
     }
     void set_divider(const lmx2594_divider& value) const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_divider(value);
         _registers_update.set_changed(11);
     }
@@ -1727,18 +1139,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_divider(value);
         _update_registers(11);
     }
     void update_divider(const lmx2594_divider& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_divider>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_divider(value); });
     }
     void set_n_divider(const lmx2594_n_divider& value) const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_n_divider(value);
         _registers_update.set_changed(36, 34);
     }
@@ -1747,18 +1161,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_n_divider(value);
         _update_registers(36, 34);
     }
     void update_n_divider(const lmx2594_n_divider& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_n_divider>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_n_divider(value); });
     }
     void set_fractional_numerator(const lmx2594_fractional_numerator& value) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_fractional_numerator(value);
         _registers_update.set_changed(43, 42);
     }
@@ -1767,18 +1183,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_fractional_numerator(value);
         _update_registers(43, 42);
     }
     void update_fractional_numerator(const lmx2594_fractional_numerator& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_fractional_numerator>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_fractional_numerator(value); });
     }
     void set_fractional_denomerator(const lmx2594_fractional_denomerator& value) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_fractional_denomerator(value);
         _registers_update.set_changed(39, 38);
     }
@@ -1787,22 +1205,25 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_fractional_denomerator(value);
         _update_registers(39, 38);
     }
     void update_fractional_denomerator(const lmx2594_fractional_denomerator& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_fractional_denomerator>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_fractional_denomerator(value); });
     }
     void vco_calibrate() const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        CHAPPI_TRACE_SPAN(__func__);
+        detail::driver_lock lock { _mutex };
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R0.bits.FCAL_EN = FCAL_EN_type::calibrate_vco;
-        write(0, _registers_map.regs.reg_R0.reg);
-        _registers_map.regs.reg_R0.bits.FCAL_EN = FCAL_EN_type::disabled;
+        _registers_map.set<FCAL_EN>(FCAL_EN_type::calibrate_vco);
+        write(0, _registers_map.array[0]);
+        _registers_map.set<FCAL_EN>(FCAL_EN_type::disabled);
     }
     void vco_calibrate(error_type& error) const noexcept
     {
@@ -1813,6 +1234,7 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_lock_detect(value);
         _registers_update.set_changed(59);
     }
@@ -1821,18 +1243,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_lock_detect(value);
         _update_registers(59);
     }
     void update_lock_detect(const lmx2594_lock_detect& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_lock_detect>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_lock_detect(value); });
     }
     void set_lock_detect_mux(const lmx2594_lock_detect_mux& value) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_lock_detect_mux(value);
         _registers_update.set_changed(0);
     }
@@ -1841,18 +1265,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_lock_detect_mux(value);
         _update_registers(0);
     }
     void update_lock_detect_mux(const lmx2594_lock_detect_mux& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_lock_detect_mux>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_lock_detect_mux(value); });
     }
     void set_phase_detector_delay(uint64_t vco_frequency) const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_phase_detector_delay(vco_frequency);
         _registers_update.set_changed(37);
     }
@@ -1861,18 +1287,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_phase_detector_delay(vco_frequency);
         _update_registers(37);
     }
     void update_phase_detector_delay(uint64_t vco_frequency, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_phase_detector_delay>(this, vco_frequency, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_phase_detector_delay(vco_frequency); });
     }
     void set_vco_calibration_divider(uint64_t osc_frequency) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_vco_calibration_divider(osc_frequency);
         _registers_update.set_changed(1, 4);
     }
@@ -1881,18 +1309,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_vco_calibration_divider(osc_frequency);
         _update_registers(1, 4);
     }
     void update_vco_calibration_divider(uint64_t osc_frequency, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_vco_calibration_divider>(this, osc_frequency, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_vco_calibration_divider(osc_frequency); });
     }
     void set_mash_order(const lmx2594_mash_order& value) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_mash_order(value);
         _registers_update.set_changed(44);
     }
@@ -1901,18 +1331,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_mash_order(value);
         _update_registers(44);
     }
     void update_mash_order(const lmx2594_mash_order& value, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_mash_order>(this, value, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_mash_order(value); });
     }
     void set_high_pd_frequency_calibration(uint32_t pd_frequency) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_high_pd_frequency_calibration(pd_frequency);
         _registers_update.set_changed(0);
     }
@@ -1921,18 +1353,20 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_high_pd_frequency_calibration(pd_frequency);
         _update_registers(0);
     }
     void update_high_pd_frequency_calibration(uint32_t pd_frequency, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_high_pd_frequency_calibration>(this, pd_frequency, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_high_pd_frequency_calibration(pd_frequency); });
     }
     void set_low_pd_frequency_calibration(uint32_t pd_frequency) const noexcept
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_low_pd_frequency_calibration(pd_frequency);
         _registers_update.set_changed(0);
     }
@@ -1941,21 +1375,24 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        detail::driver_lock lock { _mutex };
         _set_low_pd_frequency_calibration(pd_frequency);
         _update_registers(0);
     }
     void update_low_pd_frequency_calibration(uint32_t pd_frequency, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<lmx2594, error_type, NoerrorValue, &lmx2594::update_low_pd_frequency_calibration>(this, pd_frequency, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_low_pd_frequency_calibration(pd_frequency); });
     }
     auto get_n_divider_min(uint64_t vco_frequency) const
     {
+        detail::driver_lock lock { _mutex };
         using namespace lmx2594_registers;
         if (vco_frequency < lmx2594_constants::vco_frequency::min || vco_frequency > get_vco_frequency_max()) {
-            throw std::invalid_argument("lmx2594::get_n_divider_min: invalid argument");
+            raise_error(std::invalid_argument("lmx2594::get_n_divider_min: invalid argument"));
+            return uint32_t {};
         }
         uint32_t n_divider_min {};
-        switch (_registers_map.regs.reg_R44.bits.MASH_ORDER) {
+        switch (_registers_map.get<MASH_ORDER>()) {
         case MASH_ORDER_type::integer:
             if (vco_frequency > 12500000000ull) {
                 n_divider_min = 32;
@@ -1994,7 +1431,7 @@ public:
             }
             break;
         default:
-            throw std::invalid_argument("lmx2594::get_n_divider_min: invalid argument");
+            raise_error(std::invalid_argument("lmx2594::get_n_divider_min: invalid argument"));
             break;
         }
         return n_divider_min;
@@ -2005,34 +1442,38 @@ public:
     }
     auto get_osc_frequency_max() const noexcept
     {
+        detail::driver_lock lock { _mutex };
         using namespace lmx2594_registers;
-        if (_registers_map.regs.reg_R9.bits.OSC_2X != OSC_2X_type::disabled) {
+        if (_registers_map.get<OSC_2X>() != OSC_2X_type::disabled) {
             return 200000000ull;
         }
         return 1400000000ull;
     }
     auto get_pd_frequency_max() const noexcept
     {
+        detail::driver_lock lock { _mutex };
         using namespace lmx2594_registers;
-        if (_registers_map.regs.reg_R44.bits.MASH_ORDER == MASH_ORDER_type::integer) {
+        if (_registers_map.get<MASH_ORDER>() == MASH_ORDER_type::integer) {
             return 400000000u;
-        } else if (_registers_map.regs.reg_R44.bits.MASH_ORDER == MASH_ORDER_type::frac4) {
+        } else if (_registers_map.get<MASH_ORDER>() == MASH_ORDER_type::frac4) {
             return 240000000u;
         }
         return 300000000u;
     }
     auto get_pd_frequency_min() const noexcept
     {
+        detail::driver_lock lock { _mutex };
         using namespace lmx2594_registers;
-        if (_registers_map.regs.reg_R44.bits.MASH_ORDER == MASH_ORDER_type::integer) {
+        if (_registers_map.get<MASH_ORDER>() == MASH_ORDER_type::integer) {
             return 125u;
         }
         return 5000u;
     }
     auto get_vco_frequency_max() const noexcept
     {
+        detail::driver_lock lock { _mutex };
         using namespace lmx2594_registers;
-        if (_registers_map.regs.reg_R75.bits.CHDIV >= CHDIV_type::div8) {
+        if (_registers_map.get<CHDIV>() >= CHDIV_type::div8) {
             return 11500000000ull;
         }
         return 15000000000ull;
@@ -2040,19 +1481,8 @@ public:
     auto get_channel_divider(uint64_t out_frequency, double pd_frequency) const
     {
         std::underlying_type_t<lmx2594_channel_divider> chdiv {};
-        for (const auto channel_divider : lmx2594_constants::actual_channel_divider_array) {
-            const auto vco_frequency { out_frequency * channel_divider };
-            if (vco_frequency < lmx2594_constants::vco_frequency::min) {
-                ++chdiv;
-                continue;
-            }
-            if (vco_frequency > get_vco_frequency_max()) {
-                throw std::out_of_range("lmx2594::find_channel_divider: vco_frequency out of range");
-            }
-            if (vco_frequency / pd_frequency >= get_n_divider_min(vco_frequency)) {
-                break;
-            }
-            ++chdiv;
+        if (!_find_channel_divider(out_frequency, pd_frequency, chdiv)) {
+            raise_error(std::out_of_range("lmx2594::find_channel_divider: vco_frequency out of range"));
         }
         return lmx2594_channel_divider(chdiv);
     }
@@ -2093,6 +1523,8 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        CHAPPI_TRACE_SPAN(__func__);
+        detail::driver_unique_lock lock { _mutex };
         using namespace lmx2594_registers;
         const auto out_frequency { static_cast<uint64_t>(data.frequency + 0.5) };
         const auto osc_frequency { static_cast<uint64_t>(data.reference + 0.5) };
@@ -2105,42 +1537,48 @@ public:
         set_vco_calibration_divider(uint64_t(data.reference));
         set_channel_divider(lmx2594_channel_divider::div2);
         if (out_frequency > lmx2594_constants::out_frequency::max || out_frequency < lmx2594_constants::out_frequency::min) {
-            throw std::out_of_range("lmx2594::set_frequency: out_frequency out of range");
+            raise_error(std::out_of_range("lmx2594::set_frequency: out_frequency out of range"));
+            return;
         }
         if (osc_frequency < lmx2594_constants::osc_frequency::min || osc_frequency > get_osc_frequency_max()) {
-            throw std::out_of_range("lmx2594::set_frequency: osc_frequency out of range");
+            raise_error(std::out_of_range("lmx2594::set_frequency: osc_frequency out of range"));
+            return;
         }
-        double osc_frequency_ratio = register_to_integer<register_type>(_registers_map.regs.reg_R10.bits.MULT)
-            * (register_to_integer<register_type>(_registers_map.regs.reg_R9.bits.OSC_2X) + 1)
-            / double(_registers_map.regs.reg_R11.bits.PLL_R)
-            / double(_registers_map.regs.reg_R12.bits.PLL_R_PRE);
+        double osc_frequency_ratio = register_to_integer<register_type>(_registers_map.get<MULT>())
+            * (register_to_integer<register_type>(_registers_map.get<OSC_2X>()) + 1)
+            / double(_registers_map.get<PLL_R>())
+            / double(_registers_map.get<PLL_R_PRE>());
         double pd_frequency = osc_frequency * osc_frequency_ratio;
         if (pd_frequency > get_pd_frequency_max() || pd_frequency < get_pd_frequency_min()) {
-            throw std::out_of_range("lmx2594::set_frequency: pd_frequency out of range");
+            raise_error(std::out_of_range("lmx2594::set_frequency: pd_frequency out of range"));
+            return;
         }
         auto out_a_mux { OUTA_MUX_type::chdiv };
         auto out_b_mux { OUTB_MUX_type::chdiv };
         decltype(get_channel_divider({}, {})) channel_divider {};
         decltype(get_actual_channel_divider({})) actual_channel_divider {};
-        try {
-            channel_divider = get_channel_divider(out_frequency, uint64_t(pd_frequency));
+        std::underlying_type_t<lmx2594_channel_divider> chdiv {};
+        if (_find_channel_divider(out_frequency, uint64_t(pd_frequency), chdiv)) {
+            channel_divider = lmx2594_channel_divider(chdiv);
             actual_channel_divider = get_actual_channel_divider(channel_divider);
             set_channel_divider(channel_divider);
-        } catch (const std::out_of_range& e) {
+        } else {
             out_a_mux = OUTA_MUX_type::vco;
             out_b_mux = OUTB_MUX_type::vco;
             actual_channel_divider = 1;
         }
         const uint64_t vco_frequency = out_frequency * actual_channel_divider;
         if (vco_frequency < lmx2594_constants::vco_frequency::min || vco_frequency > get_vco_frequency_max()) {
-            throw std::out_of_range("lmx2594::set_frequency: vco_frequency out of range");
+            raise_error(std::out_of_range("lmx2594::set_frequency: vco_frequency out of range"));
+            return;
         }
         const double divider = double(vco_frequency) / pd_frequency;
         const uint32_t n_divider = uint32_t(divider);
         uint32_t numerator {};
         uint32_t denomerator { lmx2594_constants::fraction::denominator::max };
         if (n_divider < get_n_divider_min(vco_frequency)) {
-            throw std::out_of_range("lmx2594::set_frequency: n_divider out of range ");
+            raise_error(std::out_of_range("lmx2594::set_frequency: n_divider out of range "));
+            return;
         }
         const double num_denom_min = 1. / pd_frequency;
         if (((divider - n_divider) < num_denom_min)) {
@@ -2149,7 +1587,8 @@ public:
             numerator = 0;
         } else if (!find_num_denom(divider - n_divider, numerator, denomerator)) {
             numerator = uint32_t((divider - n_divider) * denomerator);
-            throw std::out_of_range("lmx2594::set_frequency: find_num_denom out of range ");
+            raise_error(std::out_of_range("lmx2594::set_frequency: find_num_denom out of range "));
+            return;
         }
         numerator *= lmx2594_constants::fraction::denominator::max / denomerator;
         denomerator = denomerator * (lmx2594_constants::fraction::denominator::max / denomerator);
@@ -2168,8 +1607,10 @@ public:
         set_charge_pump_gain(lmx2594_charge_pump_gain::current_15_mA);
         update_changes();
         vco_calibrate();
+        lock.unlock();
         if (!wait_lock_detect()) {
-            throw std::runtime_error("lmx2594::set_frequency: not locked!");
+            raise_error(std::runtime_error("lmx2594::set_frequency: not locked!"));
+            return;
         }
         update_charge_pump_gain(lmx2594_charge_pump_gain::current_6_mA);
 #if defined(CHAPPI_LOG_ENABLE)
@@ -2197,6 +1638,10 @@ public:
         log_info(std::string(32, '-'));
 #endif
     }
+    void set_frequency(const lmx2594_output_frequency& data, error_type& error) const noexcept
+    {
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { set_frequency(data); });
+    }
     bool is_integer_mode() const noexcept { return _is_integer_mode; }
 
 private:
@@ -2207,11 +1652,34 @@ private:
         _update_registers(other_registers...);
     }
     void _update_registers() const { }
+    // Returns false when the output needs a VCO frequency above the maximum,
+    // set_frequency() then bypasses the channel divider.
+    bool _find_channel_divider(uint64_t out_frequency, double pd_frequency, std::underlying_type_t<lmx2594_channel_divider>& chdiv) const
+    {
+        for (const auto channel_divider : lmx2594_constants::actual_channel_divider_array) {
+            const auto vco_frequency { out_frequency * channel_divider };
+            if (vco_frequency < lmx2594_constants::vco_frequency::min) {
+                ++chdiv;
+                continue;
+            }
+            if (vco_frequency > get_vco_frequency_max()) {
+                return false;
+            }
+            if (vco_frequency / pd_frequency >= get_n_divider_min(vco_frequency)) {
+                break;
+            }
+            ++chdiv;
+        }
+        return true;
+    }
+    // Reads into a local copy and leaves the shadow map alone, so lock
+    // monitors do not need the driver lock.
     auto _is_locked() const
     {
         using namespace lmx2594_registers;
-        read(110, _registers_map.regs.reg_R110.reg);
-        const auto locked = (_registers_map.regs.reg_R110.bits.rb_LD_VTUNE == rb_LD_VTUNE_type::locked) ? true : false;
+        register_type value {};
+        read(110, value);
+        const auto locked = (rb_LD_VTUNE::get(value) == rb_LD_VTUNE_type::locked) ? true : false;
         return locked;
     }
     void _set_output_enabled(const lmx2594_output_enable& data) const noexcept
@@ -2219,149 +1687,153 @@ private:
         using namespace lmx2594_registers;
         auto enabled { (data.enabled) ? OUT_PD_type::active : OUT_PD_type::powerdown };
         if (data.output == lmx2594_output::outa) {
-            _registers_map.regs.reg_R44.bits.OUTA_PD = enabled;
+            _registers_map.set<OUTA_PD>(enabled);
         }
         if (data.output == lmx2594_output::outb) {
-            _registers_map.regs.reg_R44.bits.OUTB_PD = enabled;
+            _registers_map.set<OUTB_PD>(enabled);
         }
     }
     void _set_output_power(const lmx2594_output_power& data) const noexcept
     {
         using namespace lmx2594_registers;
         if (data.output == lmx2594_output::outa) {
-            _registers_map.regs.reg_R44.bits.OUTA_PWR = data.power;
+            _registers_map.set<OUTA_PWR>(data.power);
         }
         if (data.output == lmx2594_output::outb) {
-            _registers_map.regs.reg_R45.bits.OUTB_PWR = data.power;
+            _registers_map.set<OUTB_PWR>(data.power);
         }
     }
     void _set_output_mux(const lmx2594_output_a_mux& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R45.bits.OUTA_MUX = value;
+        _registers_map.set<OUTA_MUX>(value);
     }
     void _set_output_mux(const lmx2594_output_b_mux& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R46.bits.OUTB_MUX = value;
+        _registers_map.set<OUTB_MUX>(value);
     }
     void _set_channel_divider(const lmx2594_channel_divider& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R75.bits.CHDIV = value;
-        if (_registers_map.regs.reg_R75.bits.CHDIV > CHDIV_type::div2) {
-            _registers_map.regs.reg_R31.bits.SEG1_EN = SEG1_EN_type::driver_buffer_enabled;
+        _registers_map.set<CHDIV>(value);
+        if (_registers_map.get<CHDIV>() > CHDIV_type::div2) {
+            _registers_map.set<SEG1_EN>(SEG1_EN_type::driver_buffer_enabled);
         } else {
-            _registers_map.regs.reg_R31.bits.SEG1_EN = SEG1_EN_type::disabled;
+            _registers_map.set<SEG1_EN>(SEG1_EN_type::disabled);
         }
     }
     void _set_charge_pump_gain(const lmx2594_charge_pump_gain& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R14.bits.CPG = value;
+        _registers_map.set<CPG>(value);
     }
     void _set_doubler(const lmx2594_doubler& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R9.bits.OSC_2X = value;
+        _registers_map.set<OSC_2X>(value);
     }
     void _set_pre_divider(const lmx2594_pre_divider& value) const
     {
         using namespace lmx2594_registers;
         using namespace lmx2594_constants;
         if (value < pre_divider::min || value > pre_divider::max) {
-            throw std::invalid_argument("lmx2594::set_pre_divider: invalid argument");
+            raise_error(std::invalid_argument("lmx2594::set_pre_divider: invalid argument"));
+            return;
         }
-        _registers_map.regs.reg_R12.bits.PLL_R_PRE = value;
+        _registers_map.set<PLL_R_PRE>(value);
     }
     void _set_multiplier(const lmx2594_multiplier& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R10.bits.MULT = value;
+        _registers_map.set<MULT>(value);
     }
     void _set_divider(const lmx2594_divider& value) const
     {
         using namespace lmx2594_registers;
         using namespace lmx2594_constants;
         if (value < divider::min || value > divider::max) {
-            throw std::invalid_argument("lmx2594::set_divider: invalid argument");
+            raise_error(std::invalid_argument("lmx2594::set_divider: invalid argument"));
+            return;
         }
-        _registers_map.regs.reg_R11.bits.PLL_R = value;
+        _registers_map.set<PLL_R>(value);
     }
     void _set_n_divider(const lmx2594_n_divider& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R36.bits.PLL_N_15_0 = value & 0xFFFF;
-        _registers_map.regs.reg_R34.bits.PLL_N_18_16 = (value >> 16) & 0x0007;
+        _registers_map.set<PLL_N_15_0>(value & 0xFFFF);
+        _registers_map.set<PLL_N_18_16>((value >> 16) & 0x0007);
     }
     void _set_fractional_numerator(const lmx2594_fractional_numerator& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R43.bits.PLL_NUM_15_0 = value & 0xFFFF;
-        _registers_map.regs.reg_R42.bits.PLL_NUM_31_16 = (value >> 16) & 0xFFFF;
+        _registers_map.set<PLL_NUM_15_0>(value & 0xFFFF);
+        _registers_map.set<PLL_NUM_31_16>((value >> 16) & 0xFFFF);
     }
     void _set_fractional_denomerator(const lmx2594_fractional_denomerator& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R39.bits.PLL_DEN_15_0 = value & 0xFFFF;
-        _registers_map.regs.reg_R38.bits.PLL_DEN_31_16 = (value >> 16) & 0xFFFF;
+        _registers_map.set<PLL_DEN_15_0>(value & 0xFFFF);
+        _registers_map.set<PLL_DEN_31_16>((value >> 16) & 0xFFFF);
     }
     void _set_lock_detect(const lmx2594_lock_detect& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R59.bits.LD_TYPE = value;
+        _registers_map.set<LD_TYPE>(value);
     }
     void _set_lock_detect_mux(const lmx2594_lock_detect_mux& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R0.bits.MUXOUT_LD_SEL = value;
+        _registers_map.set<MUXOUT_LD_SEL>(value);
     }
     void _set_phase_detector_delay(uint64_t vco_frequency) const
     {
         using namespace lmx2594_registers;
         if (vco_frequency < lmx2594_constants::vco_frequency::min || vco_frequency > get_vco_frequency_max()) {
-            throw std::invalid_argument("lmx2594::set_phase_detector_delay: invalid argument");
+            raise_error(std::invalid_argument("lmx2594::set_phase_detector_delay: invalid argument"));
+            return;
         }
-        switch (_registers_map.regs.reg_R44.bits.MASH_ORDER) {
+        switch (_registers_map.get<MASH_ORDER>()) {
         case MASH_ORDER_type::integer:
             if (vco_frequency > 12500000000ull) {
-                _registers_map.regs.reg_R37.bits.PFD_DLY_SEL = 2;
+                _registers_map.set<PFD_DLY_SEL>(2);
             } else {
-                _registers_map.regs.reg_R37.bits.PFD_DLY_SEL = 1;
+                _registers_map.set<PFD_DLY_SEL>(1);
             }
             break;
         case MASH_ORDER_type::frac1:
             if (vco_frequency > 12500000000ull) {
-                _registers_map.regs.reg_R37.bits.PFD_DLY_SEL = 3;
+                _registers_map.set<PFD_DLY_SEL>(3);
             } else if (vco_frequency > 10000000000ull) {
-                _registers_map.regs.reg_R37.bits.PFD_DLY_SEL = 2;
+                _registers_map.set<PFD_DLY_SEL>(2);
             } else {
-                _registers_map.regs.reg_R37.bits.PFD_DLY_SEL = 1;
+                _registers_map.set<PFD_DLY_SEL>(1);
             }
             break;
         case MASH_ORDER_type::frac2:
             if (vco_frequency > 10000000000ull) {
-                _registers_map.regs.reg_R37.bits.PFD_DLY_SEL = 3;
+                _registers_map.set<PFD_DLY_SEL>(3);
             } else {
-                _registers_map.regs.reg_R37.bits.PFD_DLY_SEL = 2;
+                _registers_map.set<PFD_DLY_SEL>(2);
             }
             break;
         case MASH_ORDER_type::frac3:
             if (vco_frequency > 10000000000ull) {
-                _registers_map.regs.reg_R37.bits.PFD_DLY_SEL = 4;
+                _registers_map.set<PFD_DLY_SEL>(4);
             } else {
-                _registers_map.regs.reg_R37.bits.PFD_DLY_SEL = 3;
+                _registers_map.set<PFD_DLY_SEL>(3);
             }
             break;
         case MASH_ORDER_type::frac4:
             if (vco_frequency > 10000000000ull) {
-                _registers_map.regs.reg_R37.bits.PFD_DLY_SEL = 6;
+                _registers_map.set<PFD_DLY_SEL>(6);
             } else {
-                _registers_map.regs.reg_R37.bits.PFD_DLY_SEL = 5;
+                _registers_map.set<PFD_DLY_SEL>(5);
             }
             break;
         default:
-            throw std::invalid_argument("lmx2594::set_phase_detector_delay: invalid argument");
+            raise_error(std::invalid_argument("lmx2594::set_phase_detector_delay: invalid argument"));
+            return;
         }
     }
     void _set_vco_calibration_divider(uint64_t osc_frequency) const noexcept
@@ -2376,37 +1848,37 @@ private:
             divider = CAL_CLK_DIV_type::div2;
         }
         const double smclk_frequency = osc_frequency / std::pow(2, register_to_integer<register_type>(divider));
-        _registers_map.regs.reg_R4.bits.ACAL_CMP_DLY = register_type(std::ceil(smclk_frequency / 10000000.)) + 1;
+        _registers_map.set<ACAL_CMP_DLY>(register_type(std::ceil(smclk_frequency / 10000000.)) + 1);
     }
     void _set_mash_order(const lmx2594_mash_order& value) const noexcept
     {
         using namespace lmx2594_registers;
-        _registers_map.regs.reg_R44.bits.MASH_ORDER = value;
+        _registers_map.set<MASH_ORDER>(value);
     }
     void _set_high_pd_frequency_calibration(uint32_t pd_frequency) const noexcept
     {
         using namespace lmx2594_registers;
         if (pd_frequency > 200000000ul) {
-            _registers_map.regs.reg_R0.bits.FCAL_HPFD_ADJ = FCAL_HPFD_ADJ_type::upper_200_MHz;
+            _registers_map.set<FCAL_HPFD_ADJ>(FCAL_HPFD_ADJ_type::upper_200_MHz);
         } else if (pd_frequency > 150000000ul) {
-            _registers_map.regs.reg_R0.bits.FCAL_HPFD_ADJ = FCAL_HPFD_ADJ_type::range_150_200_MHz;
+            _registers_map.set<FCAL_HPFD_ADJ>(FCAL_HPFD_ADJ_type::range_150_200_MHz);
         } else if (pd_frequency > 100000000ul) {
-            _registers_map.regs.reg_R0.bits.FCAL_HPFD_ADJ = FCAL_HPFD_ADJ_type::range_100_150_MHz;
+            _registers_map.set<FCAL_HPFD_ADJ>(FCAL_HPFD_ADJ_type::range_100_150_MHz);
         } else {
-            _registers_map.regs.reg_R0.bits.FCAL_HPFD_ADJ = FCAL_HPFD_ADJ_type::lower_100_MHz;
+            _registers_map.set<FCAL_HPFD_ADJ>(FCAL_HPFD_ADJ_type::lower_100_MHz);
         }
     }
     void _set_low_pd_frequency_calibration(uint32_t pd_frequency) const noexcept
     {
         using namespace lmx2594_registers;
         if (pd_frequency < 2500000ul) {
-            _registers_map.regs.reg_R0.bits.FCAL_LPFD_ADJ = FCAL_LPFD_ADJ_type::lower_2p5_MHz;
+            _registers_map.set<FCAL_LPFD_ADJ>(FCAL_LPFD_ADJ_type::lower_2p5_MHz);
         } else if (pd_frequency < 5000000ul) {
-            _registers_map.regs.reg_R0.bits.FCAL_LPFD_ADJ = FCAL_LPFD_ADJ_type::range_2p5_5_MHz;
+            _registers_map.set<FCAL_LPFD_ADJ>(FCAL_LPFD_ADJ_type::range_2p5_5_MHz);
         } else if (pd_frequency < 10000000ul) {
-            _registers_map.regs.reg_R0.bits.FCAL_LPFD_ADJ = FCAL_LPFD_ADJ_type::range_5_10_MHz;
+            _registers_map.set<FCAL_LPFD_ADJ>(FCAL_LPFD_ADJ_type::range_5_10_MHz);
         } else {
-            _registers_map.regs.reg_R0.bits.FCAL_LPFD_ADJ = FCAL_LPFD_ADJ_type::upper_10_MHz;
+            _registers_map.set<FCAL_LPFD_ADJ>(FCAL_LPFD_ADJ_type::upper_10_MHz);
         }
     }
 };
@@ -25,6 +25,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
+#include <array>
+
 #include "chappi_base.h"
 
 namespace chappi {
@@ -64,8 +66,8 @@ namespace detail {
 } // namespace detail
 
 template <typename ErrorType = int, ErrorType NoerrorValue = 0,
-    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t>
-class ltc2991 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t, typename IoPolicy = dynamic_io>
+class ltc2991 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy> {
     static constexpr auto _chip_name = "LTC2991";
     detail::ltc2991_counter _counter;
 
@@ -76,8 +78,9 @@ public:
     {
     }
     ltc2991(std::streambuf* buf_ptr = {}, reg_read_fn reg_read = {}, reg_write_fn reg_write = {}, dev_addr_type dev_addr = {})
-        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type> { buf_ptr, reg_read, reg_write, dev_addr }
+        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type, IoPolicy> { buf_ptr, reg_read, reg_write, dev_addr }
     {
+        set_name(_chip_name, get_num());
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
@@ -90,7 +93,13 @@ public:
     }
     int get_num() const noexcept final { return _counter.get_num(); }
     int get_counts() const noexcept final { return _counter.get_counts(); }
-    std::string get_name() const noexcept final { return get_name(_chip_name, get_num()); }
+    std::string get_name() const noexcept final { return get_name_cstr(); }
+    void setup_cache(cache_mode mode)
+    {
+        setup_cache(mode, _regs_num);
+        set_volatile(0x00);
+        set_volatile(_data_start_addr, _regs_num - _data_start_addr);
+    }
     void enable_all_channels() const
     {
 #if defined(CHAPPI_LOG_ENABLE)
@@ -131,7 +140,7 @@ public:
         value_type lsb {}, msb {};
         read(0x1A, msb);
         read(0x1B, lsb);
-        value = ((msb & 0b00011111) << 8 | lsb) / 16.0;
+        value = _calculate_temperature(msb, lsb);
     }
     double get_temperature() const
     {
@@ -169,15 +178,21 @@ public:
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
-        value.Tint = get_temperature();
-        value.V1 = get_voltage(ltc2991_channel::_1);
-        value.V2 = get_voltage(ltc2991_channel::_2);
-        value.V3 = get_voltage(ltc2991_channel::_3);
-        value.V4 = get_voltage(ltc2991_channel::_4);
-        value.V5 = get_voltage(ltc2991_channel::_5);
-        value.V6 = get_voltage(ltc2991_channel::_6);
-        value.V7 = get_voltage(ltc2991_channel::_7);
-        value.V8 = get_voltage(ltc2991_channel::_8);
+        std::array<value_type, _data_regs_num> regs {};
+        read_block(_data_start_addr, regs.data(), regs.size());
+        const auto voltage = [&regs](int channel) {
+            const auto idx { channel << 1 };
+            return _calculate_voltage(regs[idx], regs[idx + 1]);
+        };
+        value.V1 = voltage(0);
+        value.V2 = voltage(1);
+        value.V3 = voltage(2);
+        value.V4 = voltage(3);
+        value.V5 = voltage(4);
+        value.V6 = voltage(5);
+        value.V7 = voltage(6);
+        value.V8 = voltage(7);
+        value.Tint = _calculate_temperature(regs[_data_regs_num - 2], regs[_data_regs_num - 1]);
     }
     ltc2991_data get_data() const
     {
@@ -191,12 +206,23 @@ public:
     }
 
 private:
+    static const int _regs_num { 0x1E };
+    static const addr_type _data_start_addr { 0x0A };
+    static const int _data_regs_num { 18 };
+    static double _calculate_voltage(value_type msb, value_type lsb) noexcept
+    {
+        return ((msb & 0b00111111) << 8 | lsb) * 0.000305180;
+    }
+    static double _calculate_temperature(value_type msb, value_type lsb) noexcept
+    {
+        return ((msb & 0b00011111) << 8 | lsb) / 16.0;
+    }
     void _get_voltage(addr_type addr_msb, double& value) const
     {
         value_type val_lsb {}, val_msb {};
         read(addr_msb, val_msb);
         read(value_type(addr_msb + 1), val_lsb);
-        value = ((val_msb & 0b00111111) << 8 | val_lsb) * 0.000305180;
+        value = _calculate_voltage(val_msb, val_lsb);
     }
 };
 
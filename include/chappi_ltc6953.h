@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <thread>
@@ -61,10 +62,11 @@ namespace ltc6953_constants {
 namespace ltc6953_registers {
     using register_type = uint8_t;
     using register_addr_type = uint8_t;
-    template <typename register_bits_type, register_addr_type register_addr>
-    using register_abstract = ::chappi::register_abstract<register_type, register_bits_type, register_addr_type, register_addr>;
+    template <register_addr_type register_addr>
+    using register_abstract = ::chappi::register_abstract<register_type, register_addr_type, register_addr>;
+    template <register_addr_type register_addr, unsigned offset, unsigned width, typename field_type = register_type>
+    using register_field = ::chappi::register_field<register_type, register_addr, offset, width, field_type>;
 
-#pragma pack(push, 1)
     enum class PDALL_type : register_type {
         normal,
         powerdown
@@ -115,325 +117,271 @@ namespace ltc6953_registers {
         normal,
         slew_rate
     };
-    struct register_bits_h00 {
-        const register_type D0 : 1;
-        const register_type D1 : 1;
-        register_type VCOOK : 1;
-        register_type nVCOOK : 1;
-        const register_type D4 : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h01 {
-        register_type X0 : 1;
-        register_type X1 : 1;
-        register_type X2 : 1;
-        register_type X3 : 1;
-        register_type X4 : 1;
-        register_type X5 : 1;
-        register_type X6 : 1;
-        register_type INVSTAT : 1;
-    };
-    struct register_bits_h02 {
-        RESET_type POR : 1;
-        FILTV_type FILTV : 1;
-        const register_type D2 : 1;
-        const register_type D3 : 1;
-        const register_type D4 : 1;
-        register_type PDVCOPK : 1;
-        const register_type D6 : 1;
-        PDALL_type PDALL : 1;
-    };
-    struct register_bits_h03 {
-        PD_type PDO : 2;
-        PD_type PD1 : 2;
-        PD_type PD2 : 2;
-        PD_type PD3 : 2;
-    };
-    struct register_bits_h04 {
-        PD_type PD4 : 2;
-        PD_type PD5 : 2;
-        PD_type PD6 : 2;
-        PD_type PD7 : 2;
-    };
-    struct register_bits_h05 {
-        PD_type PD8 : 2;
-        PD_type PD9 : 2;
-        PD_type PD10 : 2;
-        const register_type D6 : 1;
-        register_type TEMPO : 1;
-    };
-    struct register_bits_h0B {
-        SSRQ_type SSRQ : 1;
-        SYSREF_PULSE_COUNT_type SYSCT : 2;
-        SRQMODE_type SRQMD : 1;
-        EZSYNC_MODE_type EZMD : 1;
-        const register_type D5 : 1;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h0C {
-        register_type MD0 : 3;
-        register_type MP0 : 5;
-    };
-    struct register_bits_h0D {
-        register_type DDEL0_H : 4;
-        OINV_type OINV0 : 1;
-        SYSREF_MODE_type MODE0 : 2;
-        SRQEN_type SRQEN0 : 1;
-    };
-    struct register_bits_h0E {
-        register_type DDEL0_L;
-    };
-    struct register_bits_h0F {
-        register_type ADEL0 : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h10 {
-        register_type MD1 : 3;
-        register_type MP1 : 5;
-    };
-    struct register_bits_h11 {
-        register_type DDEL1_H : 4;
-        OINV_type OINV1 : 1;
-        SYSREF_MODE_type MODE1 : 2;
-        SRQEN_type SRQEN1 : 1;
-    };
-    struct register_bits_h12 {
-        register_type DDEL1_L;
-    };
-    struct register_bits_h13 {
-        register_type ADEL1 : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h14 {
-        register_type MD2 : 3;
-        register_type MP2 : 5;
-    };
-    struct register_bits_h15 {
-        register_type DDEL2_H : 4;
-        OINV_type OINV2 : 1;
-        SYSREF_MODE_type MODE2 : 2;
-        SRQEN_type SRQEN2 : 1;
-    };
-    struct register_bits_h16 {
-        register_type DDEL2_L;
-    };
-    struct register_bits_h17 {
-        register_type ADEL2 : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h18 {
-        register_type MD3 : 3;
-        register_type MP3 : 5;
-    };
-    struct register_bits_h19 {
-        register_type DDEL3_H : 4;
-        OINV_type OINV3 : 1;
-        SYSREF_MODE_type MODE3 : 2;
-        SRQEN_type SRQEN3 : 1;
-    };
-    struct register_bits_h1A {
-        register_type DDEL3_L;
-    };
-    struct register_bits_h1B {
-        register_type ADEL3 : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h1C {
-        register_type MD4 : 3;
-        register_type MP4 : 5;
-    };
-    struct register_bits_h1D {
-        register_type DDEL4_H : 4;
-        OINV_type OINV4 : 1;
-        SYSREF_MODE_type MODE4 : 2;
-        SRQEN_type SRQEN4 : 1;
-    };
-    struct register_bits_h1E {
-        register_type DDEL4_L;
-    };
-    struct register_bits_h1F {
-        register_type ADEL4 : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h20 {
-        register_type MD5 : 3;
-        register_type MP5 : 5;
-    };
-    struct register_bits_h21 {
-        register_type DDEL5_H : 4;
-        OINV_type OINV5 : 1;
-        SYSREF_MODE_type MODE5 : 2;
-        SRQEN_type SRQEN5 : 1;
-    };
-    struct register_bits_h22 {
-        register_type DDEL5_L;
-    };
-    struct register_bits_h23 {
-        register_type ADEL5 : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h24 {
-        register_type MD6 : 3;
-        register_type MP6 : 5;
-    };
-    struct register_bits_h25 {
-        register_type DDEL6_H : 4;
-        OINV_type OINV6 : 1;
-        SYSREF_MODE_type MODE6 : 2;
-        SRQEN_type SRQEN6 : 1;
-    };
-    struct register_bits_h26 {
-        register_type DDEL6_L;
-    };
-    struct register_bits_h27 {
-        register_type ADEL6 : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h28 {
-        register_type MD7 : 3;
-        register_type MP7 : 5;
-    };
-    struct register_bits_h29 {
-        register_type DDEL7_H : 4;
-        OINV_type OINV7 : 1;
-        SYSREF_MODE_type MODE7 : 2;
-        SRQEN_type SRQEN7 : 1;
-    };
-    struct register_bits_h2A {
-        register_type DDEL7_L;
-    };
-    struct register_bits_h2B {
-        register_type ADEL7 : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h2C {
-        register_type MD8 : 3;
-        register_type MP8 : 5;
-    };
-    struct register_bits_h2D {
-        register_type DDEL8_H : 4;
-        OINV_type OINV8 : 1;
-        SYSREF_MODE_type MODE8 : 2;
-        SRQEN_type SRQEN8 : 1;
-    };
-    struct register_bits_h2E {
-        register_type DDEL8_L;
-    };
-    struct register_bits_h2F {
-        register_type ADEL8 : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h30 {
-        register_type MD9 : 3;
-        register_type MP9 : 5;
-    };
-    struct register_bits_h31 {
-        register_type DDEL9_H : 4;
-        OINV_type OINV9 : 1;
-        SYSREF_MODE_type MODE9 : 2;
-        SRQEN_type SRQEN9 : 1;
-    };
-    struct register_bits_h32 {
-        register_type DDEL9_L;
-    };
-    struct register_bits_h33 {
-        register_type ADEL9 : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h34 {
-        register_type MD10 : 3;
-        register_type MP10 : 5;
-    };
-    struct register_bits_h35 {
-        register_type DDEL10_H : 4;
-        OINV_type OINV10 : 1;
-        SYSREF_MODE_type MODE10 : 2;
-        SRQEN_type SRQEN10 : 1;
-    };
-    struct register_bits_h36 {
-        register_type DDEL10_L;
-    };
-    struct register_bits_h37 {
-        register_type ADEL10 : 6;
-        const register_type D6 : 1;
-        const register_type D7 : 1;
-    };
-    struct register_bits_h38 {
-        const register_type PART : 4;
-        const register_type REV : 4;
-    };
 
-#pragma pack(pop)
-    using register_h00 = register_abstract<register_bits_h00, 0x00>;
-    using register_h01 = register_abstract<register_bits_h01, 0x01>;
-    using register_h02 = register_abstract<register_bits_h02, 0x02>;
-    using register_h03 = register_abstract<register_bits_h03, 0x03>;
-    using register_h04 = register_abstract<register_bits_h04, 0x04>;
-    using register_h05 = register_abstract<register_bits_h05, 0x05>;
-    using register_h06 = register_abstract<register_8bits, 0x06>;
-    using register_h07 = register_abstract<register_8bits, 0x07>;
-    using register_h08 = register_abstract<register_8bits, 0x08>;
-    using register_h09 = register_abstract<register_8bits, 0x09>;
-    using register_h0A = register_abstract<register_8bits, 0x0A>;
-    using register_h0B = register_abstract<register_bits_h0B, 0x0B>;
-    using register_h0C = register_abstract<register_bits_h0C, 0x0C>;
-    using register_h0D = register_abstract<register_bits_h0D, 0x0D>;
-    using register_h0E = register_abstract<register_bits_h0E, 0x0E>;
-    using register_h0F = register_abstract<register_bits_h0F, 0x0F>;
-    using register_h10 = register_abstract<register_bits_h10, 0x10>;
-    using register_h11 = register_abstract<register_bits_h11, 0x11>;
-    using register_h12 = register_abstract<register_bits_h12, 0x12>;
-    using register_h13 = register_abstract<register_bits_h13, 0x13>;
-    using register_h14 = register_abstract<register_bits_h14, 0x14>;
-    using register_h15 = register_abstract<register_bits_h15, 0x15>;
-    using register_h16 = register_abstract<register_bits_h16, 0x16>;
-    using register_h17 = register_abstract<register_bits_h17, 0x17>;
-    using register_h18 = register_abstract<register_bits_h18, 0x18>;
-    using register_h19 = register_abstract<register_bits_h19, 0x19>;
-    using register_h1A = register_abstract<register_bits_h1A, 0x1A>;
-    using register_h1B = register_abstract<register_bits_h1B, 0x1B>;
-    using register_h1C = register_abstract<register_bits_h1C, 0x1C>;
-    using register_h1D = register_abstract<register_bits_h1D, 0x1D>;
-    using register_h1E = register_abstract<register_bits_h1E, 0x1E>;
-    using register_h1F = register_abstract<register_bits_h1F, 0x1F>;
-    using register_h20 = register_abstract<register_bits_h20, 0x20>;
-    using register_h21 = register_abstract<register_bits_h21, 0x21>;
-    using register_h22 = register_abstract<register_bits_h22, 0x22>;
-    using register_h23 = register_abstract<register_bits_h23, 0x23>;
-    using register_h24 = register_abstract<register_bits_h24, 0x24>;
-    using register_h25 = register_abstract<register_bits_h25, 0x25>;
-    using register_h26 = register_abstract<register_bits_h26, 0x26>;
-    using register_h27 = register_abstract<register_bits_h27, 0x27>;
-    using register_h28 = register_abstract<register_bits_h28, 0x28>;
-    using register_h29 = register_abstract<register_bits_h29, 0x29>;
-    using register_h2A = register_abstract<register_bits_h2A, 0x2A>;
-    using register_h2B = register_abstract<register_bits_h2B, 0x2B>;
-    using register_h2C = register_abstract<register_bits_h2C, 0x2C>;
-    using register_h2D = register_abstract<register_bits_h2D, 0x2D>;
-    using register_h2E = register_abstract<register_bits_h2E, 0x2E>;
-    using register_h2F = register_abstract<register_bits_h2F, 0x2F>;
-    using register_h30 = register_abstract<register_bits_h30, 0x30>;
-    using register_h31 = register_abstract<register_bits_h31, 0x31>;
-    using register_h32 = register_abstract<register_bits_h32, 0x32>;
-    using register_h33 = register_abstract<register_bits_h33, 0x33>;
-    using register_h34 = register_abstract<register_bits_h34, 0x34>;
-    using register_h35 = register_abstract<register_bits_h35, 0x35>;
-    using register_h36 = register_abstract<register_bits_h36, 0x36>;
-    using register_h37 = register_abstract<register_bits_h37, 0x37>;
-    using register_h38 = register_abstract<register_bits_h38, 0x38>;
+    using VCOOK = register_field<0x00, 2, 1>;
+    using nVCOOK = register_field<0x00, 3, 1>;
+
+    using X0 = register_field<0x01, 0, 1>;
+    using X1 = register_field<0x01, 1, 1>;
+    using X2 = register_field<0x01, 2, 1>;
+    using X3 = register_field<0x01, 3, 1>;
+    using X4 = register_field<0x01, 4, 1>;
+    using X5 = register_field<0x01, 5, 1>;
+    using X6 = register_field<0x01, 6, 1>;
+    using INVSTAT = register_field<0x01, 7, 1>;
+
+    using POR = register_field<0x02, 0, 1, RESET_type>;
+    using FILTV = register_field<0x02, 1, 1, FILTV_type>;
+    using PDVCOPK = register_field<0x02, 5, 1>;
+    using PDALL = register_field<0x02, 7, 1, PDALL_type>;
+
+    using PDO = register_field<0x03, 0, 2, PD_type>;
+    using PD1 = register_field<0x03, 2, 2, PD_type>;
+    using PD2 = register_field<0x03, 4, 2, PD_type>;
+    using PD3 = register_field<0x03, 6, 2, PD_type>;
+
+    using PD4 = register_field<0x04, 0, 2, PD_type>;
+    using PD5 = register_field<0x04, 2, 2, PD_type>;
+    using PD6 = register_field<0x04, 4, 2, PD_type>;
+    using PD7 = register_field<0x04, 6, 2, PD_type>;
+
+    using PD8 = register_field<0x05, 0, 2, PD_type>;
+    using PD9 = register_field<0x05, 2, 2, PD_type>;
+    using PD10 = register_field<0x05, 4, 2, PD_type>;
+    using TEMPO = register_field<0x05, 7, 1>;
+
+    using SSRQ = register_field<0x0B, 0, 1, SSRQ_type>;
+    using SYSCT = register_field<0x0B, 1, 2, SYSREF_PULSE_COUNT_type>;
+    using SRQMD = register_field<0x0B, 3, 1, SRQMODE_type>;
+    using EZMD = register_field<0x0B, 4, 1, EZSYNC_MODE_type>;
+
+    using MD0 = register_field<0x0C, 0, 3>;
+    using MP0 = register_field<0x0C, 3, 5>;
+
+    using DDEL0_H = register_field<0x0D, 0, 4>;
+    using OINV0 = register_field<0x0D, 4, 1, OINV_type>;
+    using MODE0 = register_field<0x0D, 5, 2, SYSREF_MODE_type>;
+    using SRQEN0 = register_field<0x0D, 7, 1, SRQEN_type>;
+
+    using DDEL0_L = register_field<0x0E, 0, 8>;
+
+    using ADEL0 = register_field<0x0F, 0, 6>;
+
+    using MD1 = register_field<0x10, 0, 3>;
+    using MP1 = register_field<0x10, 3, 5>;
+
+    using DDEL1_H = register_field<0x11, 0, 4>;
+    using OINV1 = register_field<0x11, 4, 1, OINV_type>;
+    using MODE1 = register_field<0x11, 5, 2, SYSREF_MODE_type>;
+    using SRQEN1 = register_field<0x11, 7, 1, SRQEN_type>;
+
+    using DDEL1_L = register_field<0x12, 0, 8>;
+
+    using ADEL1 = register_field<0x13, 0, 6>;
+
+    using MD2 = register_field<0x14, 0, 3>;
+    using MP2 = register_field<0x14, 3, 5>;
+
+    using DDEL2_H = register_field<0x15, 0, 4>;
+    using OINV2 = register_field<0x15, 4, 1, OINV_type>;
+    using MODE2 = register_field<0x15, 5, 2, SYSREF_MODE_type>;
+    using SRQEN2 = register_field<0x15, 7, 1, SRQEN_type>;
+
+    using DDEL2_L = register_field<0x16, 0, 8>;
+
+    using ADEL2 = register_field<0x17, 0, 6>;
+
+    using MD3 = register_field<0x18, 0, 3>;
+    using MP3 = register_field<0x18, 3, 5>;
+
+    using DDEL3_H = register_field<0x19, 0, 4>;
+    using OINV3 = register_field<0x19, 4, 1, OINV_type>;
+    using MODE3 = register_field<0x19, 5, 2, SYSREF_MODE_type>;
+    using SRQEN3 = register_field<0x19, 7, 1, SRQEN_type>;
+
+    using DDEL3_L = register_field<0x1A, 0, 8>;
+
+    using ADEL3 = register_field<0x1B, 0, 6>;
+
+    using MD4 = register_field<0x1C, 0, 3>;
+    using MP4 = register_field<0x1C, 3, 5>;
+
+    using DDEL4_H = register_field<0x1D, 0, 4>;
+    using OINV4 = register_field<0x1D, 4, 1, OINV_type>;
+    using MODE4 = register_field<0x1D, 5, 2, SYSREF_MODE_type>;
+    using SRQEN4 = register_field<0x1D, 7, 1, SRQEN_type>;
+
+    using DDEL4_L = register_field<0x1E, 0, 8>;
+
+    using ADEL4 = register_field<0x1F, 0, 6>;
+
+    using MD5 = register_field<0x20, 0, 3>;
+    using MP5 = register_field<0x20, 3, 5>;
+
+    using DDEL5_H = register_field<0x21, 0, 4>;
+    using OINV5 = register_field<0x21, 4, 1, OINV_type>;
+    using MODE5 = register_field<0x21, 5, 2, SYSREF_MODE_type>;
+    using SRQEN5 = register_field<0x21, 7, 1, SRQEN_type>;
+
+    using DDEL5_L = register_field<0x22, 0, 8>;
+
+    using ADEL5 = register_field<0x23, 0, 6>;
+
+    using MD6 = register_field<0x24, 0, 3>;
+    using MP6 = register_field<0x24, 3, 5>;
+
+    using DDEL6_H = register_field<0x25, 0, 4>;
+    using OINV6 = register_field<0x25, 4, 1, OINV_type>;
+    using MODE6 = register_field<0x25, 5, 2, SYSREF_MODE_type>;
+    using SRQEN6 = register_field<0x25, 7, 1, SRQEN_type>;
+
+    using DDEL6_L = register_field<0x26, 0, 8>;
+
+    using ADEL6 = register_field<0x27, 0, 6>;
+
+    using MD7 = register_field<0x28, 0, 3>;
+    using MP7 = register_field<0x28, 3, 5>;
+
+    using DDEL7_H = register_field<0x29, 0, 4>;
+    using OINV7 = register_field<0x29, 4, 1, OINV_type>;
+    using MODE7 = register_field<0x29, 5, 2, SYSREF_MODE_type>;
+    using SRQEN7 = register_field<0x29, 7, 1, SRQEN_type>;
+
+    using DDEL7_L = register_field<0x2A, 0, 8>;
+
+    using ADEL7 = register_field<0x2B, 0, 6>;
+
+    using MD8 = register_field<0x2C, 0, 3>;
+    using MP8 = register_field<0x2C, 3, 5>;
+
+    using DDEL8_H = register_field<0x2D, 0, 4>;
+    using OINV8 = register_field<0x2D, 4, 1, OINV_type>;
+    using MODE8 = register_field<0x2D, 5, 2, SYSREF_MODE_type>;
+    using SRQEN8 = register_field<0x2D, 7, 1, SRQEN_type>;
+
+    using DDEL8_L = register_field<0x2E, 0, 8>;
+
+    using ADEL8 = register_field<0x2F, 0, 6>;
+
+    using MD9 = register_field<0x30, 0, 3>;
+    using MP9 = register_field<0x30, 3, 5>;
+
+    using DDEL9_H = register_field<0x31, 0, 4>;
+    using OINV9 = register_field<0x31, 4, 1, OINV_type>;
+    using MODE9 = register_field<0x31, 5, 2, SYSREF_MODE_type>;
+    using SRQEN9 = register_field<0x31, 7, 1, SRQEN_type>;
+
+    using DDEL9_L = register_field<0x32, 0, 8>;
+
+    using ADEL9 = register_field<0x33, 0, 6>;
+
+    using MD10 = register_field<0x34, 0, 3>;
+    using MP10 = register_field<0x34, 3, 5>;
+
+    using DDEL10_H = register_field<0x35, 0, 4>;
+    using OINV10 = register_field<0x35, 4, 1, OINV_type>;
+    using MODE10 = register_field<0x35, 5, 2, SYSREF_MODE_type>;
+    using SRQEN10 = register_field<0x35, 7, 1, SRQEN_type>;
+
+    using DDEL10_L = register_field<0x36, 0, 8>;
+
+    using ADEL10 = register_field<0x37, 0, 6>;
+
+    using register_h00 = register_abstract<0x00>;
+    using register_h01 = register_abstract<0x01>;
+    using register_h02 = register_abstract<0x02>;
+    using register_h03 = register_abstract<0x03>;
+    using register_h04 = register_abstract<0x04>;
+    using register_h05 = register_abstract<0x05>;
+    using register_h06 = register_abstract<0x06>;
+    using register_h07 = register_abstract<0x07>;
+    using register_h08 = register_abstract<0x08>;
+    using register_h09 = register_abstract<0x09>;
+    using register_h0A = register_abstract<0x0A>;
+    using register_h0B = register_abstract<0x0B>;
+    using register_h0C = register_abstract<0x0C>;
+    using register_h0D = register_abstract<0x0D>;
+    using register_h0E = register_abstract<0x0E>;
+    using register_h0F = register_abstract<0x0F>;
+    using register_h10 = register_abstract<0x10>;
+    using register_h11 = register_abstract<0x11>;
+    using register_h12 = register_abstract<0x12>;
+    using register_h13 = register_abstract<0x13>;
+    using register_h14 = register_abstract<0x14>;
+    using register_h15 = register_abstract<0x15>;
+    using register_h16 = register_abstract<0x16>;
+    using register_h17 = register_abstract<0x17>;
+    using register_h18 = register_abstract<0x18>;
+    using register_h19 = register_abstract<0x19>;
+    using register_h1A = register_abstract<0x1A>;
+    using register_h1B = register_abstract<0x1B>;
+    using register_h1C = register_abstract<0x1C>;
+    using register_h1D = register_abstract<0x1D>;
+    using register_h1E = register_abstract<0x1E>;
+    using register_h1F = register_abstract<0x1F>;
+    using register_h20 = register_abstract<0x20>;
+    using register_h21 = register_abstract<0x21>;
+    using register_h22 = register_abstract<0x22>;
+    using register_h23 = register_abstract<0x23>;
+    using register_h24 = register_abstract<0x24>;
+    using register_h25 = register_abstract<0x25>;
+    using register_h26 = register_abstract<0x26>;
+    using register_h27 = register_abstract<0x27>;
+    using register_h28 = register_abstract<0x28>;
+    using register_h29 = register_abstract<0x29>;
+    using register_h2A = register_abstract<0x2A>;
+    using register_h2B = register_abstract<0x2B>;
+    using register_h2C = register_abstract<0x2C>;
+    using register_h2D = register_abstract<0x2D>;
+    using register_h2E = register_abstract<0x2E>;
+    using register_h2F = register_abstract<0x2F>;
+    using register_h30 = register_abstract<0x30>;
+    using register_h31 = register_abstract<0x31>;
+    using register_h32 = register_abstract<0x32>;
+    using register_h33 = register_abstract<0x33>;
+    using register_h34 = register_abstract<0x34>;
+    using register_h35 = register_abstract<0x35>;
+    using register_h36 = register_abstract<0x36>;
+    using register_h37 = register_abstract<0x37>;
+    using register_h38 = register_abstract<0x38>;
+
+    // Output n has the fields of output 0 at 4 * n registers further, the
+    // powerdown fields go four to a register from h03.
+    using MD = register_field_array<MD0, 4>;
+    using MP = register_field_array<MP0, 4>;
+    using DDEL_H = register_field_array<DDEL0_H, 4>;
+    using OINV = register_field_array<OINV0, 4>;
+    using MODE = register_field_array<MODE0, 4>;
+    using SRQEN = register_field_array<SRQEN0, 4>;
+    using DDEL_L = register_field_array<DDEL0_L, 4>;
+    using ADEL = register_field_array<ADEL0, 4>;
+    using PD = register_field_array<PDO, 1, 2, 4>;
+
+    const int register_max_num { 0x39 };
+
+    // Status h00 and the self-clearing POR in h02 and SSRQ in h0B are
+    // volatile. Power-on values are not modelled: every default is 0, so
+    // registers_table::get_defaults() is not the chip state after reset.
+    using registers_table = register_table<register_type, register_max_num,
+        register_def<0x00, 0x00, true>, register_def<0x02, 0x00, true>, register_def<0x0B, 0x00, true>>;
+    using registers_map = registers_table::registers_map;
+    using registers_update = ::chappi::registers_update<register_max_num>;
+    using registers_diff = ::chappi::registers_diff<register_type, register_max_num>;
+    using register_dump = ::chappi::register_dump<register_type, register_max_num>;
+
+    // Status h00 and revision h38 are read-only. h0B goes last, so a sync
+    // request it carries sees the outputs already set up.
+    inline const registers_diff& get_registers_diff()
+    {
+        static const registers_diff diff = [] {
+            registers_diff rules {};
+            rules.set_readonly(0x00, 0x00);
+            rules.set_readonly(0x38, 0x38);
+            rules.set_last(0x0B);
+            return rules;
+        }();
+        return diff;
+    }
 
 }; // namespace ltc6953_registers
 
@@ -500,20 +448,23 @@ namespace detail {
 } // namespace detail
 
 template <typename ErrorType = int, ErrorType NoerrorValue = 0,
-    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t>
-class ltc6953 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t, typename IoPolicy = dynamic_io>
+class ltc6953 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy> {
     static constexpr auto _chip_name = "LTC6953";
     detail::ltc6953_counter _counter;
     mutable bool _is_integer_mode {};
 
 public:
-    CHIP_BASE_RESOLVE ltc6953(bool log_enable)
+    CHIP_BASE_RESOLVE
+    using registers_table = ltc6953_registers::registers_table;
+    ltc6953(bool log_enable)
         : ltc6953 { (log_enable) ? std::clog.rdbuf() : nullptr }
     {
     }
     ltc6953(std::streambuf* buf_ptr = {}, reg_read_fn reg_read = {}, reg_write_fn reg_write = {}, dev_addr_type dev_addr = {})
-        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type> { buf_ptr, reg_read, reg_write, dev_addr }
+        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type, IoPolicy> { buf_ptr, reg_read, reg_write, dev_addr }
     {
+        set_name(_chip_name, get_num());
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
@@ -526,24 +477,67 @@ public:
     }
     int get_num() const noexcept final { return _counter.get_num(); }
     int get_counts() const noexcept final { return _counter.get_counts(); }
-    std::string get_name() const noexcept final { return get_name(_chip_name, get_num()); }
+    std::string get_name() const noexcept final { return get_name_cstr(); }
+    void setup_cache(cache_mode mode)
+    {
+        this->template setup_cache<registers_table>(mode);
+    }
     void reset() const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        CHAPPI_TRACE_SPAN(__func__);
         using namespace ltc6953_registers;
         register_h02 reg_h02 {};
         _read(reg_h02);
-        reg_h02.data.bits.POR = RESET_type::reset;
+        reg_h02.set<POR>(RESET_type::reset);
         _write(reg_h02);
-        reg_h02.data.bits.POR = RESET_type::normal;
+        reg_h02.set<POR>(RESET_type::normal);
         _write(reg_h02);
+        invalidate_cache();
     }
     void reset(error_type& error) const noexcept
     {
         helpers::noexcept_void_function<ltc6953, error_type, NoerrorValue, &ltc6953::reset>(this, error);
     }
+    // Takes the chip from the register image from, as last written, to the
+    // image to, writing only the registers that differ.
+    void update_registers_map(const ltc6953_registers::registers_map& from, const ltc6953_registers::registers_map& to) const
+    {
+#if defined(CHAPPI_LOG_ENABLE)
+        log_info(__func__);
+#endif
+        CHAPPI_TRACE_SPAN(__func__);
+        using namespace ltc6953_registers;
+        std::array<reg_data_type, register_max_num> writes {};
+        const auto writes_num = get_registers_diff().get_writes(from, to, writes.data());
+        write_batch(writes.data(), writes_num);
+    }
+    void update_registers_map(const ltc6953_registers::registers_map& from, const ltc6953_registers::registers_map& to,
+        error_type& error) const noexcept
+    {
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_registers_map(from, to); });
+    }
+    // Writes the registers marked in registers, a profile of a vendor dump,
+    // in one batch with h0B last. Read-only registers in the dump are ignored.
+    void update_registers_map(const ltc6953_registers::registers_map& registers_map,
+        const ltc6953_registers::registers_update& registers) const
+    {
+#if defined(CHAPPI_LOG_ENABLE)
+        log_info(__func__);
+#endif
+        CHAPPI_TRACE_SPAN(__func__);
+        using namespace ltc6953_registers;
+        std::array<reg_data_type, register_max_num> writes {};
+        const auto writes_num = get_registers_diff().get_writes(registers_map, registers_map, writes.data(), registers);
+        write_batch(writes.data(), writes_num);
+    }
+    void update_registers_map(const ltc6953_registers::registers_map& registers_map,
+        const ltc6953_registers::registers_update& registers, error_type& error) const noexcept
+    {
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { update_registers_map(registers_map, registers); });
+    }
     void chip_enable(bool enabled) const
     {
 #if defined(CHAPPI_LOG_ENABLE)
@@ -552,12 +546,12 @@ public:
         using namespace ltc6953_registers;
         register_h02 reg_h02 {};
         _read(reg_h02);
-        reg_h02.data.bits.PDALL = (enabled) ? PDALL_type::normal : PDALL_type::powerdown;
+        reg_h02.set<PDALL>((enabled) ? PDALL_type::normal : PDALL_type::powerdown);
         _write(reg_h02);
     }
     void chip_enable(bool enabled, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<ltc6953, error_type, NoerrorValue, &ltc6953::chip_enable>(this, enabled, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { chip_enable(enabled); });
     }
     void is_enabled(bool& enabled) const
     {
@@ -567,7 +561,7 @@ public:
         using namespace ltc6953_registers;
         register_h02 reg_h02 {};
         _read(reg_h02);
-        enabled = (reg_h02.data.bits.PDALL == PDALL_type::normal) ? true : false;
+        enabled = (reg_h02.get<PDALL>() == PDALL_type::normal) ? true : false;
     }
     bool is_enabled() const
     {
@@ -587,7 +581,7 @@ public:
         using namespace ltc6953_registers;
         register_h00 reg_h00 {};
         _read(reg_h00);
-        is_valid = bool(reg_h00.data.bits.VCOOK);
+        is_valid = bool(reg_h00.get<VCOOK>());
     }
     bool is_vco_valid() const
     {
@@ -605,94 +599,14 @@ public:
         log_info(__func__);
 #endif
         using namespace ltc6953_registers;
-        switch (data.output) {
-        case ltc6953_output::out0: {
-            register_h0D reg_h0D {};
-            _read(reg_h0D);
-            reg_h0D.data.bits.OINV0 = (data.inverted) ? OINV_type::inverted : OINV_type::normal;
-            _write(reg_h0D);
-            break;
-        }
-        case ltc6953_output::out1: {
-            register_h11 reg_h11 {};
-            _read(reg_h11);
-            reg_h11.data.bits.OINV1 = (data.inverted) ? OINV_type::inverted : OINV_type::normal;
-            _write(reg_h11);
-            break;
-        }
-        case ltc6953_output::out2: {
-            register_h15 reg_h15 {};
-            _read(reg_h15);
-            reg_h15.data.bits.OINV2 = (data.inverted) ? OINV_type::inverted : OINV_type::normal;
-            _write(reg_h15);
-            break;
-        }
-        case ltc6953_output::out3: {
-            register_h19 reg_h19 {};
-            _read(reg_h19);
-            reg_h19.data.bits.OINV3 = (data.inverted) ? OINV_type::inverted : OINV_type::normal;
-            _write(reg_h19);
-            break;
-        }
-        case ltc6953_output::out4: {
-            register_h1D reg_h1D {};
-            _read(reg_h1D);
-            reg_h1D.data.bits.OINV4 = (data.inverted) ? OINV_type::inverted : OINV_type::normal;
-            _write(reg_h1D);
-            break;
-        }
-        case ltc6953_output::out5: {
-            register_h21 reg_h21 {};
-            _read(reg_h21);
-            reg_h21.data.bits.OINV5 = (data.inverted) ? OINV_type::inverted : OINV_type::normal;
-            _write(reg_h21);
-            break;
-        }
-        case ltc6953_output::out6: {
-            register_h25 reg_h25 {};
-            _read(reg_h25);
-            reg_h25.data.bits.OINV6 = (data.inverted) ? OINV_type::inverted : OINV_type::normal;
-            _write(reg_h25);
-            break;
-        }
-        case ltc6953_output::out7: {
-            register_h29 reg_h29 {};
-            _read(reg_h29);
-            reg_h29.data.bits.OINV7 = (data.inverted) ? OINV_type::inverted : OINV_type::normal;
-            _write(reg_h29);
-            break;
-        }
-        case ltc6953_output::out8: {
-            register_h2D reg_h2D {};
-            _read(reg_h2D);
-            reg_h2D.data.bits.OINV8 = (data.inverted) ? OINV_type::inverted : OINV_type::normal;
-            _write(reg_h2D);
-            break;
-        }
-        case ltc6953_output::out9: {
-            register_h31 reg_h31 {};
-            _read(reg_h31);
-            reg_h31.data.bits.OINV9 = (data.inverted) ? OINV_type::inverted : OINV_type::normal;
-            _write(reg_h31);
-            break;
-        }
-        case ltc6953_output::out10: {
-            register_h35 reg_h35 {};
-            _read(reg_h35);
-            reg_h35.data.bits.OINV10 = (data.inverted) ? OINV_type::inverted : OINV_type::normal;
-            _write(reg_h35);
-            break;
-        }
-        default: {
-            throw std::invalid_argument("ltc6953::set_output_inversion: invalid argument for output "
-                + std::to_string(register_to_integer(data.output)));
-            break;
-        }
+        if (!_check_output(data.output, "ltc6953::set_output_inversion: invalid output")) {
+            return;
         }
+        _update_field<OINV>(data.output, (data.inverted) ? OINV_type::inverted : OINV_type::normal);
     }
     void set_output_inversion(const ltc6953_output_inversion& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<ltc6953, error_type, NoerrorValue, &ltc6953::set_output_inversion>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { set_output_inversion(data); });
     }
     void set_output_powerdown(const ltc6953_output_powerdown& data) const
     {
@@ -700,94 +614,14 @@ public:
         log_info(__func__);
 #endif
         using namespace ltc6953_registers;
-        switch (data.output) {
-        case ltc6953_output::out0: {
-            register_h03 reg_h03 {};
-            _read(reg_h03);
-            reg_h03.data.bits.PDO = data.powerdown;
-            _write(reg_h03);
-            break;
-        }
-        case ltc6953_output::out1: {
-            register_h03 reg_h03 {};
-            _read(reg_h03);
-            reg_h03.data.bits.PD1 = data.powerdown;
-            _write(reg_h03);
-            break;
-        }
-        case ltc6953_output::out2: {
-            register_h03 reg_h03 {};
-            _read(reg_h03);
-            reg_h03.data.bits.PD2 = data.powerdown;
-            _write(reg_h03);
-            break;
-        }
-        case ltc6953_output::out3: {
-            register_h03 reg_h03 {};
-            _read(reg_h03);
-            reg_h03.data.bits.PD3 = data.powerdown;
-            _write(reg_h03);
-            break;
-        }
-        case ltc6953_output::out4: {
-            register_h04 reg_h04 {};
-            _read(reg_h04);
-            reg_h04.data.bits.PD4 = data.powerdown;
-            _write(reg_h04);
-            break;
-        }
-        case ltc6953_output::out5: {
-            register_h04 reg_h04 {};
-            _read(reg_h04);
-            reg_h04.data.bits.PD5 = data.powerdown;
-            _write(reg_h04);
-            break;
-        }
-        case ltc6953_output::out6: {
-            register_h04 reg_h04 {};
-            _read(reg_h04);
-            reg_h04.data.bits.PD6 = data.powerdown;
-            _write(reg_h04);
-            break;
-        }
-        case ltc6953_output::out7: {
-            register_h04 reg_h04 {};
-            _read(reg_h04);
-            reg_h04.data.bits.PD7 = data.powerdown;
-            _write(reg_h04);
-            break;
-        }
-        case ltc6953_output::out8: {
-            register_h05 reg_h05 {};
-            _read(reg_h05);
-            reg_h05.data.bits.PD8 = data.powerdown;
-            _write(reg_h05);
-            break;
-        }
-        case ltc6953_output::out9: {
-            register_h05 reg_h05 {};
-            _read(reg_h05);
-            reg_h05.data.bits.PD9 = data.powerdown;
-            _write(reg_h05);
-            break;
-        }
-        case ltc6953_output::out10: {
-            register_h05 reg_h05 {};
-            _read(reg_h05);
-            reg_h05.data.bits.PD10 = data.powerdown;
-            _write(reg_h05);
-            break;
-        }
-        default: {
-            throw std::invalid_argument("ltc6953::set_output_powerdown: invalid argument for output "
-                + std::to_string(register_to_integer(data.output)));
-            break;
-        }
+        if (!_check_output(data.output, "ltc6953::set_output_powerdown: invalid output")) {
+            return;
         }
+        _update_field<PD>(data.output, data.powerdown);
     }
     void set_output_powerdown(const ltc6953_output_powerdown& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<ltc6953, error_type, NoerrorValue, &ltc6953::set_output_powerdown>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { set_output_powerdown(data); });
     }
     void set_digital_delay(const ltc6953_digital_delay& data) const
     {
@@ -795,132 +629,16 @@ public:
         log_info(__func__);
 #endif
         using namespace ltc6953_registers;
-        union {
-            uint16_t value;
-            uint8_t byte[2];
-        } delay;
-        delay.value = data.delay;
-        switch (data.output) {
-        case ltc6953_output::out0: {
-            register_h0D reg_h0D {};
-            _read(reg_h0D);
-            reg_h0D.data.bits.DDEL0_H = delay.byte[1];
-            _write(reg_h0D);
-            register_h0E reg_h0E {};
-            reg_h0E.data.bits.DDEL0_L = delay.byte[0];
-            _write(reg_h0E);
-            break;
-        }
-        case ltc6953_output::out1: {
-            register_h11 reg_h11 {};
-            _read(reg_h11);
-            reg_h11.data.bits.DDEL1_H = delay.byte[1];
-            _write(reg_h11);
-            register_h12 reg_h12 {};
-            reg_h12.data.bits.DDEL1_L = delay.byte[0];
-            _write(reg_h12);
-            break;
-        }
-        case ltc6953_output::out2: {
-            register_h15 reg_h15 {};
-            _read(reg_h15);
-            reg_h15.data.bits.DDEL2_H = delay.byte[1];
-            _write(reg_h15);
-            register_h16 reg_h16 {};
-            reg_h16.data.bits.DDEL2_L = delay.byte[0];
-            _write(reg_h16);
-            break;
-        }
-        case ltc6953_output::out3: {
-            register_h19 reg_h19 {};
-            _read(reg_h19);
-            reg_h19.data.bits.DDEL3_H = delay.byte[1];
-            _write(reg_h19);
-            register_h1A reg_h1A {};
-            reg_h1A.data.bits.DDEL3_L = delay.byte[0];
-            _write(reg_h1A);
-            break;
-        }
-        case ltc6953_output::out4: {
-            register_h1D reg_h1D {};
-            _read(reg_h1D);
-            reg_h1D.data.bits.DDEL4_H = delay.byte[1];
-            _write(reg_h1D);
-            register_h1E reg_h1E {};
-            reg_h1E.data.bits.DDEL4_L = delay.byte[0];
-            _write(reg_h1E);
-            break;
-        }
-        case ltc6953_output::out5: {
-            register_h21 reg_h21 {};
-            _read(reg_h21);
-            reg_h21.data.bits.DDEL5_H = delay.byte[1];
-            _write(reg_h21);
-            register_h22 reg_h22 {};
-            reg_h22.data.bits.DDEL5_L = delay.byte[0];
-            _write(reg_h22);
-            break;
-        }
-        case ltc6953_output::out6: {
-            register_h25 reg_h25 {};
-            _read(reg_h25);
-            reg_h25.data.bits.DDEL6_H = delay.byte[1];
-            _write(reg_h25);
-            register_h26 reg_h26 {};
-            reg_h26.data.bits.DDEL6_L = delay.byte[0];
-            _write(reg_h26);
-            break;
-        }
-        case ltc6953_output::out7: {
-            register_h29 reg_h29 {};
-            _read(reg_h29);
-            reg_h29.data.bits.DDEL7_H = delay.byte[1];
-            _write(reg_h29);
-            register_h2A reg_h2A {};
-            reg_h2A.data.bits.DDEL7_L = delay.byte[0];
-            _write(reg_h2A);
-            break;
-        }
-        case ltc6953_output::out8: {
-            register_h2D reg_h2D {};
-            _read(reg_h2D);
-            reg_h2D.data.bits.DDEL8_H = delay.byte[1];
-            _write(reg_h2D);
-            register_h2E reg_h2E {};
-            reg_h2E.data.bits.DDEL8_L = delay.byte[0];
-            _write(reg_h2E);
-            break;
-        }
-        case ltc6953_output::out9: {
-            register_h31 reg_h31 {};
-            _read(reg_h31);
-            reg_h31.data.bits.DDEL9_H = delay.byte[1];
-            _write(reg_h31);
-            register_h32 reg_h32 {};
-            reg_h32.data.bits.DDEL9_L = delay.byte[0];
-            _write(reg_h32);
-            break;
-        }
-        case ltc6953_output::out10: {
-            register_h35 reg_h35 {};
-            _read(reg_h35);
-            reg_h35.data.bits.DDEL10_H = delay.byte[1];
-            _write(reg_h35);
-            register_h36 reg_h36 {};
-            reg_h36.data.bits.DDEL10_L = delay.byte[0];
-            _write(reg_h36);
-            break;
-        }
-        default: {
-            throw std::invalid_argument("ltc6953::ltc6953_digital_delay: invalid argument for output "
-                + std::to_string(register_to_integer(data.output)));
-            break;
-        }
+        if (!_check_output(data.output, "ltc6953::set_digital_delay: invalid output")) {
+            return;
         }
+        const auto output = std::size_t(data.output);
+        _update_field<DDEL_H>(data.output, register_type(data.delay >> 8));
+        write(addr_type(DDEL_L::get_addr(output)), DDEL_L::set(output, {}, register_type(data.delay & 0xFF)));
     }
     void set_digital_delay(const ltc6953_digital_delay& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<ltc6953, error_type, NoerrorValue, &ltc6953::set_digital_delay>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { set_digital_delay(data); });
     }
     void set_analog_delay(const ltc6953_analog_delay& data) const
     {
@@ -929,86 +647,18 @@ public:
 #endif
         using namespace ltc6953_registers;
         if (data.delay > ltc6953_constants::analog_delay::max) {
-            throw std::overflow_error("ltc6953::set_analog_delay: overflow argument for output "
-                + std::to_string(register_to_integer(data.output)));
-        }
-        switch (data.output) {
-        case ltc6953_output::out0: {
-            register_h0F reg_h0F {};
-            reg_h0F.data.bits.ADEL0 = data.delay;
-            _write(reg_h0F);
-            break;
-        }
-        case ltc6953_output::out1: {
-            register_h13 reg_h13 {};
-            reg_h13.data.bits.ADEL1 = data.delay;
-            _write(reg_h13);
-            break;
-        }
-        case ltc6953_output::out2: {
-            register_h17 reg_h17 {};
-            reg_h17.data.bits.ADEL2 = data.delay;
-            _write(reg_h17);
-            break;
-        }
-        case ltc6953_output::out3: {
-            register_h1B reg_h1B {};
-            reg_h1B.data.bits.ADEL3 = data.delay;
-            _write(reg_h1B);
-            break;
-        }
-        case ltc6953_output::out4: {
-            register_h1F reg_h1F {};
-            reg_h1F.data.bits.ADEL4 = data.delay;
-            _write(reg_h1F);
-            break;
-        }
-        case ltc6953_output::out5: {
-            register_h23 reg_h23 {};
-            reg_h23.data.bits.ADEL5 = data.delay;
-            _write(reg_h23);
-            break;
-        }
-        case ltc6953_output::out6: {
-            register_h27 reg_h27 {};
-            reg_h27.data.bits.ADEL6 = data.delay;
-            _write(reg_h27);
-            break;
-        }
-        case ltc6953_output::out7: {
-            register_h2B reg_h2B {};
-            reg_h2B.data.bits.ADEL7 = data.delay;
-            _write(reg_h2B);
-            break;
-        }
-        case ltc6953_output::out8: {
-            register_h2F reg_h2F {};
-            reg_h2F.data.bits.ADEL8 = data.delay;
-            _write(reg_h2F);
-            break;
-        }
-        case ltc6953_output::out9: {
-            register_h33 reg_h33 {};
-            reg_h33.data.bits.ADEL9 = data.delay;
-            _write(reg_h33);
-            break;
-        }
-        case ltc6953_output::out10: {
-            register_h37 reg_h37 {};
-            reg_h37.data.bits.ADEL10 = data.delay;
-            _write(reg_h37);
-            break;
-        }
-        default: {
-            throw std::invalid_argument("ltc6953::set_analog_delay: invalid argument for output "
-                + std::to_string(register_to_integer(data.output)));
-            break;
+            raise_error(std::overflow_error("ltc6953::set_analog_delay: overflow argument"));
+            return;
         }
+        if (!_check_output(data.output, "ltc6953::set_analog_delay: invalid output")) {
+            return;
         }
+        const auto output = std::size_t(data.output);
+        write(addr_type(ADEL::get_addr(output)), ADEL::set(output, {}, register_type(data.delay)));
     }
     void set_analog_delay(const ltc6953_analog_delay& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<ltc6953, error_type, NoerrorValue, &ltc6953::set_analog_delay>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { set_analog_delay(data); });
     }
     void set_divider(const ltc6953_divider& data) const
     {
@@ -1017,8 +667,8 @@ public:
 #endif
         using namespace ltc6953_registers;
         if (data.divider > ltc6953_constants::divider::max || data.divider < ltc6953_constants::divider::min) {
-            throw std::overflow_error("ltc6953::set_divider: overflow argument for output "
-                + std::to_string(register_to_integer(data.output)));
+            raise_error(std::overflow_error("ltc6953::set_divider: overflow argument"));
+            return;
         }
         uint8_t MDx {};
         const uint8_t MDx_max = 7;
@@ -1033,102 +683,25 @@ public:
         }
         uint8_t MPx = data.divider / (1 << MDx) - 1;
         if (data.divider % (1 << MDx) != 0) {
+#if defined(CHAPPI_LOG_ENABLE)
             const auto factor { double(data.divider) / (1 << MDx) };
             uint16_t nearest_low = std::floor(factor) * (1 << MDx);
             uint16_t nearest_high = std::ceil(factor) * (1 << MDx);
-            throw std::invalid_argument("ltc6953::set_divider: invalid argument for output "
-                + std::to_string(register_to_integer(data.output))
-                + "\nDivider must be a multiple of " + std::to_string((1 << MDx))
-                + "\nNearest value are " + std::to_string(nearest_low) + " or " + std::to_string(nearest_high));
-        }
-        switch (data.output) {
-        case ltc6953_output::out0: {
-            register_h0C reg_h0C {};
-            reg_h0C.data.bits.MP0 = MPx;
-            reg_h0C.data.bits.MD0 = MDx;
-            _write(reg_h0C);
-            break;
-        }
-        case ltc6953_output::out1: {
-            register_h10 reg_h10 {};
-            reg_h10.data.bits.MP1 = MPx;
-            reg_h10.data.bits.MD1 = MDx;
-            _write(reg_h10);
-            break;
-        }
-        case ltc6953_output::out2: {
-            register_h14 reg_h14 {};
-            reg_h14.data.bits.MP2 = MPx;
-            reg_h14.data.bits.MD2 = MDx;
-            _write(reg_h14);
-            break;
-        }
-        case ltc6953_output::out3: {
-            register_h18 reg_h18 {};
-            reg_h18.data.bits.MP3 = MPx;
-            reg_h18.data.bits.MD3 = MDx;
-            _write(reg_h18);
-            break;
-        }
-        case ltc6953_output::out4: {
-            register_h1C reg_h1C {};
-            reg_h1C.data.bits.MP4 = MPx;
-            reg_h1C.data.bits.MD4 = MDx;
-            _write(reg_h1C);
-            break;
-        }
-        case ltc6953_output::out5: {
-            register_h20 reg_h20 {};
-            reg_h20.data.bits.MP5 = MPx;
-            reg_h20.data.bits.MD5 = MDx;
-            _write(reg_h20);
-            break;
-        }
-        case ltc6953_output::out6: {
-            register_h24 reg_h24 {};
-            reg_h24.data.bits.MP6 = MPx;
-            reg_h24.data.bits.MD6 = MDx;
-            _write(reg_h24);
-            break;
-        }
-        case ltc6953_output::out7: {
-            register_h28 reg_h28 {};
-            reg_h28.data.bits.MP7 = MPx;
-            reg_h28.data.bits.MD7 = MDx;
-            _write(reg_h28);
-            break;
-        }
-        case ltc6953_output::out8: {
-            register_h2C reg_h2C {};
-            reg_h2C.data.bits.MP8 = MPx;
-            reg_h2C.data.bits.MD8 = MDx;
-            _write(reg_h2C);
-            break;
-        }
-        case ltc6953_output::out9: {
-            register_h30 reg_h30 {};
-            reg_h30.data.bits.MP9 = MPx;
-            reg_h30.data.bits.MD9 = MDx;
-            _write(reg_h30);
-            break;
-        }
-        case ltc6953_output::out10: {
-            register_h34 reg_h34 {};
-            reg_h34.data.bits.MP10 = MPx;
-            reg_h34.data.bits.MD10 = MDx;
-            _write(reg_h34);
-            break;
-        }
-        default: {
-            throw std::invalid_argument("ltc6953::set_divider: invalid argument for output "
-                + std::to_string(register_to_integer(data.output)));
-            break;
+            log << '[' << get_name_cstr() << ']' << " divider must be a multiple of " << (1 << MDx)
+                << ", nearest values are " << nearest_low << " or " << nearest_high << '\n';
+#endif
+            raise_error(std::invalid_argument("ltc6953::set_divider: divider is not a multiple of the prescaler step"));
+            return;
         }
+        if (!_check_output(data.output, "ltc6953::set_divider: invalid output")) {
+            return;
         }
+        const auto output = std::size_t(data.output);
+        write(addr_type(MP::get_addr(output)), MD::set(output, MP::set(output, {}, MPx), MDx));
     }
     void set_divider(const ltc6953_divider& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<ltc6953, error_type, NoerrorValue, &ltc6953::set_divider>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { set_divider(data); });
     }
     void set_output_sync_mode(const ltc6953_output_sync_mode& data) const
     {
@@ -1136,161 +709,95 @@ public:
         log_info(__func__);
 #endif
         using namespace ltc6953_registers;
-        switch (data.output) {
-        case ltc6953_output::out0: {
-            register_h0D reg_h0D {};
-            _read(reg_h0D);
-            reg_h0D.data.bits.SRQEN0 = (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled;
-            reg_h0D.data.bits.MODE0 = data.mode;
-            _write(reg_h0D);
-            break;
-        }
-        case ltc6953_output::out1: {
-            register_h11 reg_h11 {};
-            _read(reg_h11);
-            reg_h11.data.bits.SRQEN1 = (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled;
-            reg_h11.data.bits.MODE1 = data.mode;
-            _write(reg_h11);
-            break;
-        }
-        case ltc6953_output::out2: {
-            register_h15 reg_h15 {};
-            _read(reg_h15);
-            reg_h15.data.bits.SRQEN2 = (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled;
-            reg_h15.data.bits.MODE2 = data.mode;
-            _write(reg_h15);
-            break;
-        }
-        case ltc6953_output::out3: {
-            register_h19 reg_h19 {};
-            _read(reg_h19);
-            reg_h19.data.bits.SRQEN3 = (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled;
-            reg_h19.data.bits.MODE3 = data.mode;
-            _write(reg_h19);
-            break;
-        }
-        case ltc6953_output::out4: {
-            register_h1D reg_h1D {};
-            _read(reg_h1D);
-            reg_h1D.data.bits.SRQEN4 = (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled;
-            reg_h1D.data.bits.MODE4 = data.mode;
-            _write(reg_h1D);
-            break;
-        }
-        case ltc6953_output::out5: {
-            register_h21 reg_h21 {};
-            _read(reg_h21);
-            reg_h21.data.bits.SRQEN5 = (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled;
-            reg_h21.data.bits.MODE5 = data.mode;
-            _write(reg_h21);
-            break;
-        }
-        case ltc6953_output::out6: {
-            register_h25 reg_h25 {};
-            _read(reg_h25);
-            reg_h25.data.bits.SRQEN6 = (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled;
-            reg_h25.data.bits.MODE6 = data.mode;
-            _write(reg_h25);
-            break;
-        }
-        case ltc6953_output::out7: {
-            register_h29 reg_h29 {};
-            _read(reg_h29);
-            reg_h29.data.bits.SRQEN7 = (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled;
-            reg_h29.data.bits.MODE7 = data.mode;
-            _write(reg_h29);
-            break;
-        }
-        case ltc6953_output::out8: {
-            register_h2D reg_h2D {};
-            _read(reg_h2D);
-            reg_h2D.data.bits.SRQEN8 = (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled;
-            reg_h2D.data.bits.MODE8 = data.mode;
-            _write(reg_h2D);
-            break;
-        }
-        case ltc6953_output::out9: {
-            register_h31 reg_h31 {};
-            _read(reg_h31);
-            reg_h31.data.bits.SRQEN9 = (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled;
-            reg_h31.data.bits.MODE9 = data.mode;
-            _write(reg_h31);
-            break;
-        }
-        case ltc6953_output::out10: {
-            register_h35 reg_h35 {};
-            _read(reg_h35);
-            reg_h35.data.bits.SRQEN10 = (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled;
-            reg_h35.data.bits.MODE10 = data.mode;
-            _write(reg_h35);
-            break;
-        }
-        default: {
-            throw std::invalid_argument("ltc6953::set_sync_enabled: invalid argument for output "
-                + std::to_string(register_to_integer(data.output)));
-            break;
-        }
+        if (!_check_output(data.output, "ltc6953::set_output_sync_mode: invalid output")) {
+            return;
         }
+        const auto output = std::size_t(data.output);
+        const auto addr = addr_type(SRQEN::get_addr(output));
+        register_type value {};
+        read(addr, value);
+        value = SRQEN::set(output, value, (data.enabled) ? SRQEN_type::enabled : SRQEN_type::disabled);
+        write(addr, MODE::set(output, value, data.mode));
     }
     void set_output_sync_mode(const ltc6953_output_sync_mode& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<ltc6953, error_type, NoerrorValue, &ltc6953::set_output_sync_mode>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { set_output_sync_mode(data); });
     }
     void sync_request() const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
+        CHAPPI_TRACE_SPAN(__func__);
         using namespace ltc6953_registers;
         register_h0B reg_h0B {};
         _read(reg_h0B);
-        reg_h0B.data.bits.SSRQ = SSRQ_type::synchronization;
+        reg_h0B.set<SSRQ>(SSRQ_type::synchronization);
         _write(reg_h0B);
+        if (error_raised()) {
+            return;
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        reg_h0B.data.bits.SSRQ = SSRQ_type::normal;
+        reg_h0B.set<SSRQ>(SSRQ_type::normal);
         _write(reg_h0B);
     }
     void sync_request(error_type& error) const noexcept
     {
         helpers::noexcept_void_function<ltc6953, error_type, NoerrorValue, &ltc6953::sync_request>(this, error);
     }
-    void set_sync_mode(const ltc6953_sync_mode& data)
+    void set_sync_mode(const ltc6953_sync_mode& data) const
     {
         using namespace ltc6953_registers;
         register_h0B reg_h0B {};
         _read(reg_h0B);
-        reg_h0B.data.bits.SRQMD = data.srq_mode;
-        reg_h0B.data.bits.SYSCT = data.pulse_count;
-        reg_h0B.data.bits.EZMD = (data.ezsync_mode) ? EZSYNC_MODE_type::ez_sync_mode : EZSYNC_MODE_type::normal;
+        reg_h0B.set<SRQMD, SYSCT, EZMD>(data.srq_mode, data.pulse_count,
+            (data.ezsync_mode) ? EZSYNC_MODE_type::ez_sync_mode : EZSYNC_MODE_type::normal);
         _write(reg_h0B);
     }
     void set_sync_mode(const ltc6953_sync_mode& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<ltc6953, error_type, NoerrorValue, &ltc6953::set_sync_mode>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { set_sync_mode(data); });
     }
-    void set_input_buffer(bool slew_rate)
+    void set_input_buffer(bool slew_rate) const
     {
         using namespace ltc6953_registers;
         register_h02 reg_h02 {};
         _read(reg_h02);
-        reg_h02.data.bits.FILTV = (slew_rate) ? FILTV_type::slew_rate : FILTV_type::normal;
+        reg_h02.set<FILTV>((slew_rate) ? FILTV_type::slew_rate : FILTV_type::normal);
         _write(reg_h02);
     }
     void set_input_buffer(bool slew_rate, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<ltc6953, error_type, NoerrorValue, &ltc6953::set_input_buffer>(this, slew_rate, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { set_input_buffer(slew_rate); });
     }
 
 private:
-    template <typename register_bits_type, ltc6953_registers::register_addr_type register_addr>
-    void _read(ltc6953_registers::register_abstract<register_bits_type, register_addr>& reg) const
+    bool _check_output(ltc6953_output output, const char* error_msg) const
+    {
+        if (register_to_integer(output) >= ltc6953_constants::output_max_num) {
+            raise_error(std::invalid_argument(error_msg));
+            return false;
+        }
+        return true;
+    }
+    // Read-modify-write of the field of one output.
+    template <typename FieldArray>
+    void _update_field(ltc6953_output output, typename FieldArray::field_type field_value) const
+    {
+        const auto addr = addr_type(FieldArray::get_addr(std::size_t(output)));
+        ltc6953_registers::register_type value {};
+        read(addr, value);
+        write(addr, FieldArray::set(std::size_t(output), value, field_value));
+    }
+    template <ltc6953_registers::register_addr_type register_addr>
+    void _read(ltc6953_registers::register_abstract<register_addr>& reg) const
     {
-        read(reg.addr, reg.data.value);
+        read(reg.addr, reg.value);
     }
-    template <typename register_bits_type, ltc6953_registers::register_addr_type register_addr>
-    void _write(const ltc6953_registers::register_abstract<register_bits_type, register_addr>& reg) const
+    template <ltc6953_registers::register_addr_type register_addr>
+    void _write(const ltc6953_registers::register_abstract<register_addr>& reg) const
     {
-        write(reg.addr, reg.data.value);
+        write(reg.addr, reg.value);
     }
 };
 
@@ -25,53 +25,208 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <forward_list>
+#include <string>
+#include <type_traits>
 
 namespace chappi {
 
-#pragma pack(push, 1)
-
-struct register_8bits {
-    const uint8_t D0 : 1;
-    const uint8_t D1 : 1;
-    const uint8_t D2 : 1;
-    const uint8_t D3 : 1;
-    const uint8_t D4 : 1;
-    const uint8_t D5 : 1;
-    const uint8_t D6 : 1;
-    const uint8_t D7 : 1;
+// A field of a register: width bits at offset in the register at addr,
+// read and written as field_type. Shifts and masks are compile-time
+// constants, so a field access is a plain and/or on the register value and
+// the layout does not depend on how the compiler packs bitfields.
+template <typename RegisterType, std::size_t Addr, unsigned Offset, unsigned Width = sizeof(RegisterType) * 8,
+    typename FieldType = RegisterType>
+struct register_field {
+    static_assert(Width > 0 && Offset + Width <= sizeof(RegisterType) * 8, "field does not fit the register");
+    using register_type = RegisterType;
+    using field_type = FieldType;
+    static constexpr std::size_t addr { Addr };
+    static constexpr unsigned offset { Offset };
+    static constexpr unsigned width { Width };
+    static constexpr register_type mask { register_type((~uint64_t {} >> (64 - Width)) << Offset) };
+
+    static constexpr field_type get(register_type reg) noexcept
+    {
+        return static_cast<field_type>((reg & mask) >> Offset);
+    }
+    // The field value in place, other bits clear.
+    static constexpr register_type bits(field_type value) noexcept
+    {
+        return register_type((register_type(value) << Offset) & mask);
+    }
+    static constexpr register_type set(register_type reg, field_type value) noexcept
+    {
+        return register_type((reg & ~mask) | bits(value));
+    }
 };
 
-struct register_16bits {
-    const uint16_t D0 : 1;
-    const uint16_t D1 : 1;
-    const uint16_t D2 : 1;
-    const uint16_t D3 : 1;
-    const uint16_t D4 : 1;
-    const uint16_t D5 : 1;
-    const uint16_t D6 : 1;
-    const uint16_t D7 : 1;
-    const uint16_t D8 : 1;
-    const uint16_t D9 : 1;
-    const uint16_t D10 : 1;
-    const uint16_t D11 : 1;
-    const uint16_t D12 : 1;
-    const uint16_t D13 : 1;
-    const uint16_t D14 : 1;
-    const uint16_t D15 : 1;
+// A field repeated for each channel of a chip, Field being channel 0.
+// Channel n sits n * addr_step registers further, or for fields packed
+// per_register to a register, n % per_register * offset_step bits further
+// within register n / per_register * addr_step.
+template <typename Field, std::size_t AddrStep, unsigned OffsetStep = 0, std::size_t PerRegister = 1>
+struct register_field_array {
+    using register_type = typename Field::register_type;
+    using field_type = typename Field::field_type;
+
+    static constexpr std::size_t get_addr(std::size_t channel) noexcept
+    {
+        return Field::addr + channel / PerRegister * AddrStep;
+    }
+    static constexpr register_type get_mask(std::size_t channel) noexcept
+    {
+        return register_type(Field::mask << (channel % PerRegister * OffsetStep));
+    }
+    static constexpr field_type get(std::size_t channel, register_type reg) noexcept
+    {
+        return static_cast<field_type>((reg & get_mask(channel)) >> (Field::offset + channel % PerRegister * OffsetStep));
+    }
+    static constexpr register_type set(std::size_t channel, register_type reg, field_type value) noexcept
+    {
+        return register_type((reg & ~get_mask(channel))
+            | ((register_type(value) << (Field::offset + channel % PerRegister * OffsetStep)) & get_mask(channel)));
+    }
 };
 
-#pragma pack(pop)
+namespace detail {
+    template <typename Field, typename... Fields>
+    struct fields_traits {
+        using register_type = typename Field::register_type;
+        static constexpr register_type mask { Field::mask };
+        static constexpr bool same_register { true };
+    };
+    template <typename Field, typename Next, typename... Fields>
+    struct fields_traits<Field, Next, Fields...> {
+        using register_type = typename Field::register_type;
+        static constexpr register_type mask { register_type(Field::mask | fields_traits<Next, Fields...>::mask) };
+        static constexpr bool same_register { Field::addr == Next::addr && fields_traits<Next, Fields...>::same_register };
+    };
+} // namespace detail
 
-template <typename register_type, typename register_bits_type,
-    typename register_addr_type, register_addr_type register_addr>
+// Sets several fields of one register with a single merged mask.
+template <typename... Fields>
+constexpr auto set_fields(typename detail::fields_traits<Fields...>::register_type reg,
+    typename Fields::field_type... values) noexcept
+{
+    using traits = detail::fields_traits<Fields...>;
+    static_assert(traits::same_register, "fields of different registers");
+    typename traits::register_type bits {};
+    const typename traits::register_type field_bits[] { Fields::bits(values)... };
+    for (const auto field : field_bits) {
+        bits |= field;
+    }
+    return typename traits::register_type((reg & ~traits::mask) | bits);
+}
+
+// A register value to be read or written at register_addr, with access by
+// field descriptors of that register.
+template <typename register_type, typename register_addr_type, register_addr_type register_addr>
 struct register_abstract {
-    union register_data_type {
-        register_type value {};
-        register_bits_type bits;
-    } data {};
+    register_type value {};
     const register_addr_type addr { register_addr };
+
+    template <typename Field>
+    constexpr typename Field::field_type get() const noexcept
+    {
+        static_assert(Field::addr == register_addr, "field of another register");
+        return Field::get(value);
+    }
+    template <typename Field, typename... Fields>
+    void set(typename Field::field_type field_value, typename Fields::field_type... field_values) noexcept
+    {
+        static_assert(Field::addr == register_addr, "field of another register");
+        value = set_fields<Field, Fields...>(value, field_value, field_values...);
+    }
+};
+
+// The shadow copy of a chip's registers, indexed by address.
+template <typename register_type, std::size_t register_max_num>
+struct registers_map {
+    register_type array[register_max_num] {};
+
+    template <typename Field>
+    constexpr typename Field::field_type get() const noexcept
+    {
+        static_assert(Field::addr < register_max_num, "field out of the map");
+        return Field::get(array[Field::addr]);
+    }
+    template <typename Field, typename... Fields>
+    void set(typename Field::field_type field_value, typename Fields::field_type... field_values) noexcept
+    {
+        static_assert(Field::addr < register_max_num, "field out of the map");
+        array[Field::addr] = set_fields<Field, Fields...>(array[Field::addr], field_value, field_values...);
+    }
+};
+
+// A register of a register_table: the address, the value after reset and
+// whether the chip changes it on its own, as status, readback and
+// self-clearing registers do, which keeps it out of the cache.
+template <std::size_t Addr, uint64_t Default = 0, bool Volatile = false>
+struct register_def {
+    static constexpr std::size_t addr { Addr };
+    static constexpr uint64_t default_value { Default };
+    static constexpr bool is_volatile { Volatile };
+};
+
+namespace detail {
+    template <typename RegisterType, std::size_t RegisterMaxNum, typename... Registers>
+    constexpr bool is_register_table_valid() noexcept
+    {
+        const bool valid[] { true,
+            (Registers::addr < RegisterMaxNum && Registers::default_value <= RegisterType(~RegisterType {}))... };
+        for (const auto register_valid : valid) {
+            if (!register_valid) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace detail
+
+// A chip declared as a table of registers. The shadow map, its reset values
+// and the volatile registers come from the table at compile time; registers
+// left out reset to 0 and are cached.
+template <typename RegisterType, std::size_t RegisterMaxNum, typename... Registers>
+struct register_table {
+    static_assert(detail::is_register_table_valid<RegisterType, RegisterMaxNum, Registers...>(),
+        "register out of the table or default wider than the register");
+    using register_type = RegisterType;
+    static constexpr std::size_t register_max_num { RegisterMaxNum };
+    using registers_map = ::chappi::registers_map<register_type, register_max_num>;
+
+    static constexpr registers_map get_defaults() noexcept
+    {
+        registers_map map {};
+        const std::size_t addrs[] { register_max_num, Registers::addr... };
+        const uint64_t values[] { 0, Registers::default_value... };
+        for (std::size_t pos { 1 }; pos < sizeof(addrs) / sizeof(addrs[0]); ++pos) {
+            map.array[addrs[pos]] = register_type(values[pos]);
+        }
+        return map;
+    }
+    static constexpr bool is_volatile(std::size_t addr) noexcept
+    {
+        const bool found[] { false, (Registers::addr == addr && Registers::is_volatile)... };
+        for (const auto register_found : found) {
+            if (register_found) {
+                return true;
+            }
+        }
+        return false;
+    }
+    template <typename Function>
+    static void for_each_volatile(Function&& fn)
+    {
+        const std::size_t addrs[] { register_max_num, ((Registers::is_volatile) ? Registers::addr : register_max_num)... };
+        for (const auto addr : addrs) {
+            if (addr != register_max_num) {
+                fn(addr);
+            }
+        }
+    }
 };
 
 template <typename register_type = std::size_t, typename value_type>
@@ -80,15 +235,35 @@ constexpr register_type register_to_integer(value_type value) noexcept
     return static_cast<std::underlying_type_t<value_type>>(value);
 }
 
+namespace detail {
+    inline std::size_t highest_bit(uint64_t word) noexcept
+    {
+#if defined(__GNUC__)
+        return std::size_t(63 - __builtin_clzll(word));
+#else
+        std::size_t bit {};
+        while (word >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+} // namespace detail
+
+// Marks registers changed since the last update in a bitset, one bit per
+// register, so marking twice is harmless. get_changed() yields the highest
+// changed register first, which puts R0 last when the changes are flushed.
 template <std::size_t register_max_num>
 class registers_update {
-    std::forward_list<std::size_t> _changed_registers {};
+    static constexpr std::size_t _word_bits { 64 };
+    static constexpr std::size_t _words_num { (register_max_num + _word_bits - 1) / _word_bits };
+    std::array<uint64_t, _words_num> _changed_registers {};
 
 public:
     registers_update() = default;
     auto is_valid(std::size_t register_num) const noexcept
     {
-        if (register_num < 0 || register_num > register_max_num - 1) {
+        if (register_num > register_max_num - 1) {
             return false;
         }
         return true;
@@ -98,32 +273,120 @@ public:
         if (!is_valid(register_num)) {
             return false;
         }
-        auto result = std::find(_changed_registers.cbegin(), _changed_registers.cend(), register_num);
-        if (result != _changed_registers.cend()) {
-            return true;
+        return (_changed_registers[register_num / _word_bits] >> (register_num % _word_bits) & 1) != 0;
+    }
+    auto is_changed() const noexcept
+    {
+        for (const auto word : _changed_registers) {
+            if (word != 0) {
+                return true;
+            }
         }
         return false;
     }
-    auto is_changed() const noexcept { return !_changed_registers.empty(); }
     template <typename Arg = std::size_t, typename... Args>
     auto set_changed(Arg register_num, Args... other_registers) noexcept
     {
-        if (!is_valid(register_num)) {
+        if (!is_valid(std::size_t(register_num))) {
             return false;
         }
-        _changed_registers.push_front(register_num);
+        _changed_registers[std::size_t(register_num) / _word_bits] |= uint64_t(1) << (std::size_t(register_num) % _word_bits);
         return set_changed(other_registers...);
     }
     auto set_changed() noexcept { return true; }
-    auto get_changed() const noexcept { return _changed_registers.front(); }
+    // The highest changed register, register_max_num when none is.
+    auto get_changed() const noexcept
+    {
+        for (auto word_num = _words_num; word_num-- > 0;) {
+            if (_changed_registers[word_num] != 0) {
+                return word_num * _word_bits + detail::highest_bit(_changed_registers[word_num]);
+            }
+        }
+        return register_max_num;
+    }
     auto clear_changed(std::size_t register_num) noexcept
     {
         if (!is_valid(register_num)) {
             return false;
         }
-        _changed_registers.remove(register_num);
+        _changed_registers[register_num / _word_bits] &= ~(uint64_t(1) << (register_num % _word_bits));
         return true;
     }
 };
 
+// The minimal ordered write list between two full register images of a
+// chip: each register that differs once, from the highest down, skipping
+// read-only registers. Registers set as last follow all the others in the
+// order they were set; a strobe register is written whenever any other
+// register is, because the chip acts on the new values only when it sees
+// that write (R0 with FCAL_EN on LMX2594).
+template <typename register_type, std::size_t register_max_num>
+class registers_diff {
+    registers_update<register_max_num> _readonly {};
+    registers_update<register_max_num> _last {};
+    std::array<std::size_t, register_max_num> _last_order {};
+    std::array<bool, register_max_num> _strobe {};
+    std::size_t _last_num {};
+
+public:
+    using registers_map_type = registers_map<register_type, register_max_num>;
+
+    registers_diff() = default;
+    auto set_readonly(std::size_t begin, std::size_t end) noexcept
+    {
+        for (auto register_num = begin; register_num <= end; ++register_num) {
+            if (!_readonly.set_changed(register_num)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    auto set_last(std::size_t register_num, bool strobe = false) noexcept
+    {
+        if (_last.is_changed(register_num) || !_last.set_changed(register_num)) {
+            return false;
+        }
+        _last_order[_last_num++] = register_num;
+        _strobe[register_num] = strobe;
+        return true;
+    }
+    // Fills writes, room for register_max_num entries of { addr, value },
+    // and returns their number. Registers marked in forced are written even
+    // if equal, for shadow values the chip has not seen yet.
+    template <typename Data>
+    std::size_t get_writes(const registers_map_type& from, const registers_map_type& to, Data* writes,
+        const registers_update<register_max_num>& forced = {}) const noexcept
+    {
+        using addr_type = decltype(writes->addr);
+        using value_type = decltype(writes->value);
+        std::size_t writes_num {};
+        for (auto register_num = register_max_num; register_num-- > 0;) {
+            if (_readonly.is_changed(register_num) || _last.is_changed(register_num)) {
+                continue;
+            }
+            if (from.array[register_num] != to.array[register_num] || forced.is_changed(register_num)) {
+                writes[writes_num++] = { addr_type(register_num), value_type(to.array[register_num]) };
+            }
+        }
+        const auto others_num = writes_num;
+        for (std::size_t pos {}; pos < _last_num; ++pos) {
+            const auto register_num = _last_order[pos];
+            if (from.array[register_num] != to.array[register_num] || forced.is_changed(register_num)
+                || (_strobe[register_num] && others_num != 0)) {
+                writes[writes_num++] = { addr_type(register_num), value_type(to.array[register_num]) };
+            }
+        }
+        return writes_num;
+    }
+};
+
+// One profile of a vendor register dump: the values and which registers the
+// dump sets.
+template <typename register_type, std::size_t register_max_num>
+struct register_dump {
+    std::string profile {};
+    registers_map<register_type, register_max_num> values {};
+    registers_update<register_max_num> registers {};
+};
+
 } // namespace chappi
@@ -38,8 +38,8 @@ namespace detail {
 } // namespace detail
 
 template <typename ErrorType = int, ErrorType NoerrorValue = 0,
-    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t>
-class si57x final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t, typename IoPolicy = dynamic_io>
+class si57x final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy> {
     static constexpr auto _chip_name = "Si57x";
     detail::si57x_counter _counter;
     static const int _freq_regs_num { 12 };
@@ -54,8 +54,9 @@ public:
     {
     }
     si57x(std::streambuf* buf_ptr = {}, reg_read_fn reg_read = {}, reg_write_fn reg_write = {}, dev_addr_type dev_addr = {})
-        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type> { buf_ptr, reg_read, reg_write, dev_addr }
+        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type, IoPolicy> { buf_ptr, reg_read, reg_write, dev_addr }
     {
+        set_name(_chip_name, get_num());
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
@@ -68,13 +69,20 @@ public:
     }
     int get_num() const noexcept final { return _counter.get_num(); }
     int get_counts() const noexcept final { return _counter.get_counts(); }
-    std::string get_name() const noexcept final { return get_name(_chip_name, get_num()); }
+    std::string get_name() const noexcept final { return get_name_cstr(); }
+    void setup_cache(cache_mode mode)
+    {
+        setup_cache(mode, 138);
+        set_volatile(135);
+        set_volatile(137);
+    }
     void reset() const
     {
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
         write(135, 0x80);
+        invalidate_cache();
     }
     void reset(error_type& error) const noexcept
     {
@@ -109,14 +117,10 @@ public:
 #endif
         freq_regs_type freq_regs {};
         if (_make_freq_regs(value, _fxtal, freq_regs) != true) {
-            auto error_msg = std::string("can't calulate parameters for ") + get_name();
-            throw std::runtime_error(error_msg);
-        }
-        addr_type addr { start_addr };
-        for (auto& reg : freq_regs) {
-            write(addr, reg);
-            ++addr;
+            raise_error(std::runtime_error("si57x::set_freq: can't calculate parameters"));
+            return;
         }
+        write_block(start_addr, freq_regs.data(), freq_regs.size());
     }
     void set_freq(double value, error_type& error) const noexcept
     {
@@ -128,11 +132,7 @@ public:
         log_info(__func__);
 #endif
         freq_regs_type freq_regs {};
-        addr_type addr { start_addr };
-        for (auto& reg : freq_regs) {
-            read(addr, reg);
-            ++addr;
-        }
+        read_block(start_addr, freq_regs.data(), freq_regs.size());
         value = _calculate_freq(_fxtal, freq_regs);
     }
     double get_freq(error_type& error) const noexcept
@@ -147,22 +147,21 @@ public:
     }
     void set_fxtal(double fxtal) noexcept { _fxtal = fxtal; }
     double get_fxtal() const noexcept { return _fxtal; }
-    void calib_fxtal(double freq_gen) noexcept
+    void calib_fxtal(double freq_gen)
     {
         freq_regs_type freq_regs {};
-        addr_type addr { start_addr };
-        for (auto& reg : freq_regs) {
-            read(addr, reg);
-            ++addr;
+        read_block(start_addr, freq_regs.data(), freq_regs.size());
+        if (error_raised()) {
+            return;
         }
         _fxtal = _calculate_fxtal(freq_gen, freq_regs);
 #if defined(CHAPPI_LOG_ENABLE)
-        log << '[' << get_name() << ']' << " Fxtal = " << std::setprecision(12) << _fxtal << '\n';
+        log << '[' << get_name_cstr() << ']' << " Fxtal = " << std::setprecision(12) << _fxtal << '\n';
 #endif
     }
-    void calib_fxtal(double freq_gen, error_type& error) const noexcept
+    void calib_fxtal(double freq_gen, error_type& error) noexcept
     {
-        helpers::noexcept_set_function<si57x, error_type, NoerrorValue, double, &si57x::freeze_dco>(this, freq_gen, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { calib_fxtal(freq_gen); });
     }
 
 private:
@@ -0,0 +1,673 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "chappi_base.h"
+#include "chappi_ltc2991.h"
+
+namespace chappi {
+
+enum class sim_bus_type {
+    none,
+    i2c,
+    spi
+};
+
+// How long the bus is busy per transaction. On I2C every byte takes 9 clocks
+// with its acknowledge, a frame adds start and stop and the device address,
+// and a read addresses the device a second time after a repeated start. On
+// SPI a frame is the register address followed by the data, 8 clocks per
+// byte. The overhead is charged once per transaction for what the host adds
+// around it, such as a system call or chip select setup. Zero address or
+// value bytes mean the size of the register types.
+struct sim_bus_timing {
+    sim_bus_type type {};
+    double clock {};
+    std::chrono::nanoseconds overhead {};
+    std::size_t address_bytes {};
+    std::size_t value_bytes {};
+
+    static sim_bus_timing i2c(double clock = 100e3, std::chrono::nanoseconds overhead = {}) noexcept
+    {
+        return { sim_bus_type::i2c, clock, overhead, 0, 0 };
+    }
+    static sim_bus_timing spi(double clock, std::chrono::nanoseconds overhead = {}) noexcept
+    {
+        return { sim_bus_type::spi, clock, overhead, 0, 0 };
+    }
+    // Bus time of one transaction of frames frames moving bytes data bytes.
+    std::chrono::nanoseconds get_time(bool read, std::size_t frames, std::size_t address_bytes,
+        std::size_t bytes) const noexcept
+    {
+        if (type == sim_bus_type::none || clock <= 0) {
+            return overhead;
+        }
+        std::size_t clocks {};
+        if (type == sim_bus_type::i2c) {
+            const std::size_t frame_clocks { 1 + 9 + address_bytes * 9 + 1 + (read ? 1 + 9 : 0) };
+            clocks = frames * frame_clocks + bytes * 9;
+        } else {
+            clocks = (frames * address_bytes + bytes) * 8;
+        }
+        return overhead + std::chrono::nanoseconds(std::llround(clocks * 1e9 / clock));
+    }
+};
+
+enum class sim_op {
+    read,
+    write,
+    read_block,
+    write_block,
+    write_batch
+};
+
+// One recorded transaction, addr is the first register it touched.
+template <typename AddrType>
+struct sim_transaction {
+    sim_op op {};
+    AddrType addr {};
+    std::size_t count {};
+    bool failed {};
+};
+
+// A register file standing in for a chip on the bus. It implements the
+// reg_read_fn/reg_write_fn contract, plus the block and batch callbacks,
+// and counts one transaction per call, so tests and benchmarks run the
+// drivers without hardware. Every transaction waits the configured latency
+// and may be made to fail. Chip models derive from it and give registers
+// their meaning in on_read()/on_write(), plain registers just keep the last
+// value written. With a sim_bus_timing set, the device also accounts the
+// time a real bus would be busy with the transactions. Recording keeps the
+// sequence of transactions for checks on bus traffic.
+template <typename ErrorType = int, ErrorType NoerrorValue = 0,
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t>
+class sim_device {
+public:
+    using error_type = ErrorType;
+    using dev_addr_type = DevAddrType;
+    using addr_type = AddrType;
+    using value_type = ValueType;
+    using reg_data_type = reg_data<addr_type, value_type>;
+    using transaction_type = sim_transaction<addr_type>;
+
+    explicit sim_device(std::size_t size = 256)
+        : _regs(size)
+    {
+    }
+    sim_device(const sim_device&) = delete;
+    sim_device& operator=(const sim_device&) = delete;
+    virtual ~sim_device() noexcept = default;
+    void set_latency(std::chrono::nanoseconds latency) noexcept { _latency = latency; }
+    // Simulated bus time is only accounted, the wait is set_latency().
+    void set_timing(const sim_bus_timing& timing) noexcept { _timing = timing; }
+    const sim_bus_timing& get_timing() const noexcept { return _timing; }
+    std::chrono::nanoseconds get_latency() const noexcept { return _latency; }
+    // The next count transactions fail with error and leave the registers
+    // alone.
+    void inject_error(error_type error, std::size_t count = 1)
+    {
+        std::lock_guard<std::mutex> lock { _mutex };
+        _error = error;
+        _error_count = count;
+    }
+    std::size_t get_transactions() const noexcept { return _transactions; }
+    std::size_t get_reads() const noexcept { return _reads; }
+    std::size_t get_writes() const noexcept { return _writes; }
+    // Register data moved, without addressing and framing.
+    std::size_t get_bytes() const noexcept { return (_reads + _writes) * sizeof(value_type); }
+    void set_recording(bool enabled) noexcept { _recording = enabled; }
+    const std::vector<transaction_type>& get_record() const noexcept { return _record; }
+    // The time the bus was busy with the transactions since the last reset.
+    std::chrono::nanoseconds get_bus_time() const noexcept { return _bus_time; }
+    void reset_counters() noexcept
+    {
+        _bus_time = {};
+        _transactions = 0;
+        _reads = 0;
+        _writes = 0;
+        _record.clear();
+    }
+    // Raw register access without side effects, latency or counting.
+    value_type peek(std::size_t index) const noexcept { return (index < _regs.size()) ? _regs[index] : value_type {}; }
+    void poke(std::size_t index, value_type value) noexcept
+    {
+        if (index < _regs.size()) {
+            _regs[index] = value;
+        }
+    }
+    error_type read(dev_addr_type, addr_type addr, value_type& value)
+    {
+        std::lock_guard<std::mutex> lock { _mutex };
+        const auto error = _transaction(sim_op::read, addr, 1, 0, 1);
+        if (error == NoerrorValue) {
+            value = on_read(addr);
+        }
+        return error;
+    }
+    error_type write(dev_addr_type, addr_type addr, value_type value)
+    {
+        std::lock_guard<std::mutex> lock { _mutex };
+        const auto error = _transaction(sim_op::write, addr, 0, 1, 1);
+        if (error == NoerrorValue) {
+            on_write(addr, value);
+        }
+        return error;
+    }
+    error_type read_block(dev_addr_type, addr_type addr, value_type* values, std::size_t count)
+    {
+        std::lock_guard<std::mutex> lock { _mutex };
+        const auto error = _transaction(sim_op::read_block, addr, count, 0, 1);
+        for (std::size_t i {}; i < count && error == NoerrorValue; ++i) {
+            values[i] = on_read(addr_type(addr + i));
+        }
+        return error;
+    }
+    error_type write_block(dev_addr_type, addr_type addr, const value_type* values, std::size_t count)
+    {
+        std::lock_guard<std::mutex> lock { _mutex };
+        const auto error = _transaction(sim_op::write_block, addr, 0, count, 1);
+        for (std::size_t i {}; i < count && error == NoerrorValue; ++i) {
+            on_write(addr_type(addr + i), values[i]);
+        }
+        return error;
+    }
+    error_type write_batch(dev_addr_type, const reg_data_type* data, std::size_t count)
+    {
+        std::lock_guard<std::mutex> lock { _mutex };
+        const auto error = _transaction(sim_op::write_batch, (count != 0) ? data[0].addr : addr_type {}, 0, count, count);
+        for (std::size_t i {}; i < count && error == NoerrorValue; ++i) {
+            on_write(data[i].addr, data[i].value);
+        }
+        return error;
+    }
+    // Installs the device as the chip's bus, with block and batch transfers.
+    template <typename ChipType>
+    void attach(ChipType& chip, dev_addr_type dev_addr = {})
+    {
+        static_assert(std::is_same<typename ChipType::error_type, error_type>::value
+                && std::is_same<typename ChipType::dev_addr_type, dev_addr_type>::value
+                && std::is_same<typename ChipType::addr_type, addr_type>::value
+                && std::is_same<typename ChipType::value_type, value_type>::value,
+            "chip and device register types differ");
+        chip.setup_io(
+            [this](dev_addr_type dev_addr, addr_type addr, value_type& value) { return read(dev_addr, addr, value); },
+            [this](dev_addr_type dev_addr, addr_type addr, value_type value) { return write(dev_addr, addr, value); },
+            dev_addr);
+        chip.setup_block_io(
+            [this](dev_addr_type dev_addr, addr_type addr, value_type* values, std::size_t count) {
+                return read_block(dev_addr, addr, values, count);
+            },
+            [this](dev_addr_type dev_addr, addr_type addr, const value_type* values, std::size_t count) {
+                return write_block(dev_addr, addr, values, count);
+            });
+        chip.setup_batch_io([this](dev_addr_type dev_addr, const reg_data_type* data, std::size_t count) {
+            return write_batch(dev_addr, data, count);
+        });
+    }
+
+protected:
+    virtual value_type on_read(addr_type addr) { return peek(std::size_t(addr)); }
+    virtual void on_write(addr_type addr, value_type value) { poke(std::size_t(addr), value); }
+
+    std::vector<value_type> _regs;
+
+private:
+    error_type _transaction(sim_op op, addr_type addr, std::size_t reads, std::size_t writes, std::size_t frames)
+    {
+        const auto address_bytes = (_timing.address_bytes != 0) ? _timing.address_bytes : sizeof(addr_type);
+        const auto value_bytes = (_timing.value_bytes != 0) ? _timing.value_bytes : sizeof(value_type);
+        _bus_time += _timing.get_time(reads != 0, frames, address_bytes, (reads + writes) * value_bytes);
+        if (_latency.count() > 0) {
+            const auto deadline = std::chrono::steady_clock::now() + _latency;
+            // Sleeping is too coarse for short latencies, spin the rest.
+            if (_latency > std::chrono::microseconds(200)) {
+                std::this_thread::sleep_for(_latency - std::chrono::microseconds(100));
+            }
+            while (std::chrono::steady_clock::now() < deadline) {
+            }
+        }
+        ++_transactions;
+        const bool failed { _error_count != 0 };
+        if (_recording) {
+            _record.push_back({ op, addr, reads + writes, failed });
+        }
+        if (failed) {
+            --_error_count;
+            return _error;
+        }
+        _reads += reads;
+        _writes += writes;
+        return NoerrorValue;
+    }
+
+    std::mutex _mutex {};
+    std::chrono::nanoseconds _latency {};
+    sim_bus_timing _timing {};
+    std::chrono::nanoseconds _bus_time {};
+    error_type _error { NoerrorValue };
+    std::size_t _error_count {};
+    std::size_t _transactions {};
+    std::size_t _reads {};
+    std::size_t _writes {};
+    bool _recording {};
+    std::vector<transaction_type> _record {};
+};
+
+// The result registers hold the inputs set with set_voltage(),
+// set_temperature() and set_vcc(), flagged valid for the channel pairs
+// enabled in register 0x01. Results are single-ended voltages and the
+// internal temperature in Celsius.
+template <typename ErrorType = int, ErrorType NoerrorValue = 0,
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t>
+class sim_ltc2991 final : public sim_device<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    using base_type = sim_device<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>;
+
+public:
+    using typename base_type::addr_type;
+    using typename base_type::value_type;
+
+    sim_ltc2991()
+        : base_type { 0x1E }
+    {
+    }
+    void set_voltage(ltc2991_channel channel, double volts) noexcept { _voltage[static_cast<int>(channel)] = volts; }
+    void set_temperature(double celsius) noexcept { _temperature = celsius; }
+    void set_vcc(double volts) noexcept { _vcc = volts; }
+
+private:
+    static constexpr double _voltage_lsb { 0.000305180 };
+    value_type on_read(addr_type addr) final
+    {
+        const auto control = this->_regs[0x01];
+        if (addr == 0x00) {
+            value_type status {};
+            for (int pair {}; pair < 4; ++pair) {
+                if (control & (0x10 << pair)) {
+                    status |= value_type(0x03 << (pair * 2));
+                }
+            }
+            return status;
+        }
+        if (addr == 0x01) {
+            return (control & 0x08) ? value_type((control & 0xF8) | 0x03) : value_type(control & 0xF8);
+        }
+        if (addr < 0x0A || addr >= 0x1E) {
+            return this->peek(addr);
+        }
+        const int index { (addr - 0x0A) >> 1 };
+        const bool valid = (index < 8) ? (control & (0x10 << (index >> 1))) : (control & 0x08);
+        int code {};
+        if (index < 8) {
+            code = int(std::lround(_voltage[index] / _voltage_lsb)) & 0x7FFF;
+        } else if (index == 8) {
+            code = int(std::lround(_temperature * 16.0)) & 0x1FFF;
+        } else {
+            code = int(std::lround((_vcc - 2.5) / _voltage_lsb)) & 0x7FFF;
+        }
+        if (((addr - 0x0A) & 1) != 0) {
+            return value_type(code & 0xFF);
+        }
+        return value_type((valid ? 0x80 : 0x00) | (code >> 8));
+    }
+    void on_write(addr_type addr, value_type value) final
+    {
+        if (addr < 0x0A) {
+            this->_regs[addr] = value;
+        }
+    }
+
+    double _voltage[8] {};
+    double _temperature { 25.0 };
+    double _vcc { 3.3 };
+};
+
+// Register 0 is the read-back port: writing it selects the register the
+// next read of register 0 returns, 0 selects the chip id.
+template <typename ErrorType = int, ErrorType NoerrorValue = 0,
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t>
+class sim_hmc987 final : public sim_device<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    using base_type = sim_device<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>;
+
+public:
+    using typename base_type::addr_type;
+    using typename base_type::value_type;
+
+    explicit sim_hmc987(value_type chip_id = {})
+        : base_type { 8 }
+        , _chip_id { chip_id }
+    {
+    }
+
+private:
+    value_type on_read(addr_type addr) final
+    {
+        if (addr != 0x00) {
+            return this->peek(addr);
+        }
+        return (_read_select == 0) ? _chip_id : this->peek(_read_select);
+    }
+    void on_write(addr_type addr, value_type value) final
+    {
+        if (addr == 0x00) {
+            _read_select = std::size_t(value & 0x07);
+            return;
+        }
+        this->poke(addr, value);
+    }
+
+    const value_type _chip_id;
+    std::size_t _read_select {};
+};
+
+// Writes carry the register number above a 3-bit chip address and only
+// reach the model when the chip address matches. The read_control field of
+// register 0 selects the register returned by reads, 0 selects the chip id,
+// and soft_reset clears every register.
+template <typename ErrorType = int, ErrorType NoerrorValue = 0,
+    typename DevAddrType = uint16_t, typename AddrType = uint16_t, typename ValueType = uint16_t>
+class sim_hmc988 final : public sim_device<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    using base_type = sim_device<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>;
+
+public:
+    using typename base_type::addr_type;
+    using typename base_type::value_type;
+
+    explicit sim_hmc988(unsigned chip_addr = 0, value_type chip_id = {})
+        : base_type { 16 }
+        , _chip_addr { chip_addr & 0x07 }
+        , _chip_id { chip_id }
+    {
+    }
+
+private:
+    value_type on_read(addr_type) final
+    {
+        const auto read_control = std::size_t(this->_regs[0] & 0x0F);
+        return (read_control == 0) ? _chip_id : this->peek(read_control);
+    }
+    void on_write(addr_type addr, value_type value) final
+    {
+        if ((addr & 0x07) != _chip_addr) {
+            return;
+        }
+        const auto reg = std::size_t(addr >> 3);
+        if (reg == 0 && (value & 0x10)) {
+            std::fill(this->_regs.begin(), this->_regs.end(), value_type {});
+            return;
+        }
+        this->poke(reg, value);
+    }
+
+    const unsigned _chip_addr;
+    const value_type _chip_id;
+};
+
+// Keeps the programmed divider registers and calibrates the VCO when R0 is
+// written with FCAL_EN set. The PLL locks if the resulting VCO frequency,
+// from the reference set with set_reference(), is within 7.5-15 GHz, and
+// loses lock on reset, power down or a change of the divider registers.
+// R110-R112 read back the lock state, the selected VCO and its calibration.
+template <typename ErrorType = int, ErrorType NoerrorValue = 0,
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint16_t>
+class sim_lmx2594 final : public sim_device<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    using base_type = sim_device<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>;
+
+public:
+    using typename base_type::addr_type;
+    using typename base_type::value_type;
+
+    sim_lmx2594()
+        : base_type { 113 }
+    {
+    }
+    void set_reference(double frequency) noexcept { _reference = frequency; }
+    // A device that is not lockable never reports lock, like one with a
+    // broken loop filter.
+    void set_lockable(bool lockable) noexcept { _lockable = lockable; }
+    bool is_locked() const noexcept { return _locked; }
+    double get_vco_frequency() const noexcept { return _vco_frequency; }
+
+private:
+    static constexpr double _vco_min { 7.5e9 };
+    static constexpr double _vco_max { 15.0e9 };
+    value_type on_read(addr_type addr) final
+    {
+        switch (addr) {
+        case 110:
+            return value_type((_locked ? 2u : 0u) << 9 | _vco_sel << 5);
+        case 111:
+            return value_type(_locked ? _capctrl : 0u);
+        case 112:
+            return value_type(_locked ? 300u : 0u);
+        default:
+            return this->peek(addr);
+        }
+    }
+    void on_write(addr_type addr, value_type value) final
+    {
+        if (addr >= 110) {
+            return;
+        }
+        this->poke(addr, value);
+        switch (addr) {
+        case 0:
+            if (value & 0x0002) {
+                std::fill(this->_regs.begin(), this->_regs.end(), value_type {});
+                _locked = false;
+            } else if (value & 0x0001) {
+                _locked = false;
+            } else if (value & 0x0008) {
+                _calibrate();
+            }
+            break;
+        case 9:
+        case 10:
+        case 11:
+        case 12:
+        case 34:
+        case 36:
+        case 38:
+        case 39:
+        case 42:
+        case 43:
+            _locked = false;
+            break;
+        default:
+            break;
+        }
+    }
+    void _calibrate() noexcept
+    {
+        const auto& regs = this->_regs;
+        const double mult = (regs[10] >> 7) & 0x1F;
+        const double osc_2x = (regs[9] >> 12) & 0x01;
+        const double pll_r = (regs[11] >> 4) & 0xFF;
+        const double pll_r_pre = regs[12] & 0x0FFF;
+        const uint32_t n = uint32_t(regs[34] & 0x07) << 16 | regs[36];
+        const uint32_t num = uint32_t(regs[42]) << 16 | regs[43];
+        const uint32_t den = uint32_t(regs[38]) << 16 | regs[39];
+        _vco_frequency = 0;
+        _locked = false;
+        if (mult == 0 || pll_r == 0 || pll_r_pre == 0) {
+            return;
+        }
+        const double pd_frequency = _reference * mult * (osc_2x + 1) / pll_r / pll_r_pre;
+        _vco_frequency = pd_frequency * (n + ((den != 0) ? double(num) / den : 0.0));
+        if (!_lockable || _vco_frequency < _vco_min || _vco_frequency > _vco_max) {
+            return;
+        }
+        // VCO1-VCO7 split the range at these frequencies.
+        const double vco_edges[] { 8.6e9, 9.8e9, 10.8e9, 12.0e9, 12.9e9, 13.9e9, _vco_max };
+        double low { _vco_min };
+        for (unsigned vco {}; vco < 7; ++vco) {
+            if (_vco_frequency <= vco_edges[vco]) {
+                _vco_sel = vco + 1;
+                _capctrl = unsigned(183 * (vco_edges[vco] - _vco_frequency) / (vco_edges[vco] - low));
+                break;
+            }
+            low = vco_edges[vco];
+        }
+        _locked = true;
+    }
+
+    double _reference { 100e6 };
+    bool _lockable { true };
+    bool _locked {};
+    double _vco_frequency {};
+    unsigned _vco_sel {};
+    unsigned _capctrl {};
+};
+
+// The output frequency follows RFREQ, HS_DIV and N1 in registers 7-12 (13-18
+// on 7 ppm parts, see start_addr) from the crystal frequency. New values
+// take effect immediately, or when the DCO is unfrozen through register 137
+// or NewFreq is set in register 135. RST_REG and RECALL in register 135
+// restore the startup frequency.
+template <typename ErrorType = int, ErrorType NoerrorValue = 0,
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t>
+class sim_si57x final : public sim_device<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    using base_type = sim_device<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType>;
+
+public:
+    using typename base_type::addr_type;
+    using typename base_type::value_type;
+
+    explicit sim_si57x(double startup_frequency = 156.25e6, double fxtal = 114.285e6, addr_type start_addr = 7)
+        : base_type { 138 }
+        , _fxtal { fxtal }
+        , _start_addr { start_addr }
+    {
+        _encode(startup_frequency, fxtal, _startup);
+        _recall();
+    }
+    double get_frequency() const noexcept { return _frequency; }
+    double get_fxtal() const noexcept { return _fxtal; }
+
+private:
+    value_type on_read(addr_type addr) final
+    {
+        return this->peek(addr);
+    }
+    void on_write(addr_type addr, value_type value) final
+    {
+        if (addr == 135) {
+            if (value & 0x81) {
+                _recall();
+            } else if (value & 0x40) {
+                _apply();
+            }
+            this->poke(addr, value_type(value & 0x3E));
+            return;
+        }
+        if (addr == 137) {
+            const bool frozen = this->_regs[137] & 0x10;
+            this->poke(addr, value);
+            if (frozen && !(value & 0x10)) {
+                _apply();
+            }
+            return;
+        }
+        this->poke(addr, value);
+        if (addr >= _start_addr && addr < _start_addr + 6 && !(this->_regs[137] & 0x10)) {
+            _apply();
+        }
+    }
+    void _recall() noexcept
+    {
+        for (std::size_t i {}; i < 6; ++i) {
+            this->_regs[_start_addr + i] = _startup[i];
+        }
+        _apply();
+    }
+    void _apply() noexcept
+    {
+        const auto reg = [this](std::size_t i) { return uint32_t(this->_regs[_start_addr + i]); };
+        const uint32_t hs_div = (reg(0) >> 5) + 4;
+        const uint32_t n1 = ((reg(0) & 0x1F) << 2 | reg(1) >> 6) + 1;
+        const uint32_t rfreq_int = (reg(1) & 0x3F) << 4 | reg(2) >> 4;
+        const uint32_t rfreq_frac = (reg(2) & 0x0F) << 24 | reg(3) << 16 | reg(4) << 8 | reg(5);
+        const double rfreq = rfreq_int + rfreq_frac / double(1 << 28);
+        _frequency = _fxtal * rfreq / (hs_div * n1);
+    }
+    // Picks the dividers with the lowest DCO frequency, as the driver does.
+    static void _encode(double frequency, double fxtal, value_type (&regs)[6]) noexcept
+    {
+        const unsigned hs_divs[] { 4, 5, 6, 7, 9, 11 };
+        double dco { 5.67e9 };
+        unsigned hs_div {};
+        unsigned n1 {};
+        for (unsigned n { 1 }; n <= 128; n = (n == 1) ? 2 : n + 2) {
+            for (const auto hs : hs_divs) {
+                const double f = frequency * hs * n;
+                if (f >= 4.85e9 && f <= dco) {
+                    dco = f;
+                    hs_div = hs;
+                    n1 = n;
+                }
+            }
+        }
+        if (hs_div == 0) {
+            return;
+        }
+        const double rfreq = dco / fxtal;
+        const auto rfreq_int = uint32_t(rfreq);
+        const auto rfreq_frac = uint32_t((rfreq - rfreq_int) * double(1 << 28));
+        regs[0] = value_type((hs_div - 4) << 5 | (n1 - 1) >> 2);
+        regs[1] = value_type(((n1 - 1) & 0x03) << 6 | rfreq_int >> 4);
+        regs[2] = value_type((rfreq_int & 0x0F) << 4 | rfreq_frac >> 24);
+        regs[3] = value_type(rfreq_frac >> 16);
+        regs[4] = value_type(rfreq_frac >> 8);
+        regs[5] = value_type(rfreq_frac);
+    }
+
+    const double _fxtal;
+    const addr_type _start_addr;
+    value_type _startup[6] {};
+    double _frequency {};
+};
+
+// Plain register files for the chips whose registers need no model.
+template <typename ErrorType = int, ErrorType NoerrorValue = 0>
+using sim_ad5621 = sim_device<ErrorType, NoerrorValue, uint8_t, uint8_t, uint16_t>;
+template <typename ErrorType = int, ErrorType NoerrorValue = 0>
+using sim_adn4600 = sim_device<ErrorType, NoerrorValue, uint8_t, uint8_t, uint16_t>;
+template <typename ErrorType = int, ErrorType NoerrorValue = 0>
+using sim_ina219 = sim_device<ErrorType, NoerrorValue, uint8_t, uint8_t, uint16_t>;
+template <typename ErrorType = int, ErrorType NoerrorValue = 0>
+using sim_ltc6953 = sim_device<ErrorType, NoerrorValue, uint8_t, uint8_t, uint8_t>;
+template <typename ErrorType = int, ErrorType NoerrorValue = 0>
+using sim_tca6424 = sim_device<ErrorType, NoerrorValue, uint8_t, uint8_t, uint8_t>;
+
+} // namespace chappi
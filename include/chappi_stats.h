@@ -0,0 +1,127 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace chappi {
+
+// Snapshot of the bus statistics of one chip. Every call into the I/O
+// callbacks lands in one latency bucket: bucket i counts calls that took
+// from 2^i up to 2^(i+1) nanoseconds, the last bucket also takes anything
+// slower.
+struct io_stats {
+    static constexpr std::size_t buckets_num { 32 };
+    uint64_t calls {};
+    uint64_t reads {};
+    uint64_t writes {};
+    uint64_t bytes_read {};
+    uint64_t bytes_written {};
+    uint64_t errors {};
+    uint64_t retries {};
+    uint64_t latency_total_ns {};
+    uint64_t latency_max_ns {};
+    uint64_t latency_buckets[buckets_num] {};
+    static constexpr uint64_t bucket_floor_ns(std::size_t bucket) noexcept { return uint64_t(1) << bucket; }
+};
+
+namespace detail {
+    // Counters may be bumped from several threads, e.g. a lock monitor next
+    // to a writer, so they are relaxed atomics.
+    class io_stats_counter {
+    public:
+        void record(bool read, std::size_t regs, std::size_t bytes, bool failed, std::chrono::nanoseconds latency) noexcept
+        {
+            const auto latency_ns = uint64_t(latency.count());
+            _calls.fetch_add(1, std::memory_order_relaxed);
+            (read ? _reads : _writes).fetch_add(regs, std::memory_order_relaxed);
+            (read ? _bytes_read : _bytes_written).fetch_add(bytes, std::memory_order_relaxed);
+            if (failed) {
+                _errors.fetch_add(1, std::memory_order_relaxed);
+            }
+            _latency_total_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+            auto max = _latency_max_ns.load(std::memory_order_relaxed);
+            while (latency_ns > max && !_latency_max_ns.compare_exchange_weak(max, latency_ns, std::memory_order_relaxed)) {
+            }
+            _latency_buckets[_bucket(latency_ns)].fetch_add(1, std::memory_order_relaxed);
+        }
+        void record_retry() noexcept { _retries.fetch_add(1, std::memory_order_relaxed); }
+        io_stats snapshot() const noexcept
+        {
+            io_stats stats {};
+            stats.calls = _calls.load(std::memory_order_relaxed);
+            stats.reads = _reads.load(std::memory_order_relaxed);
+            stats.writes = _writes.load(std::memory_order_relaxed);
+            stats.bytes_read = _bytes_read.load(std::memory_order_relaxed);
+            stats.bytes_written = _bytes_written.load(std::memory_order_relaxed);
+            stats.errors = _errors.load(std::memory_order_relaxed);
+            stats.retries = _retries.load(std::memory_order_relaxed);
+            stats.latency_total_ns = _latency_total_ns.load(std::memory_order_relaxed);
+            stats.latency_max_ns = _latency_max_ns.load(std::memory_order_relaxed);
+            for (std::size_t i {}; i < io_stats::buckets_num; ++i) {
+                stats.latency_buckets[i] = _latency_buckets[i].load(std::memory_order_relaxed);
+            }
+            return stats;
+        }
+        void reset() noexcept
+        {
+            for (auto counter : { &_calls, &_reads, &_writes, &_bytes_read, &_bytes_written, &_errors, &_retries, &_latency_total_ns, &_latency_max_ns }) {
+                counter->store(0, std::memory_order_relaxed);
+            }
+            for (auto& bucket : _latency_buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        static std::size_t _bucket(uint64_t latency_ns) noexcept
+        {
+            std::size_t bucket {};
+            while (latency_ns > 1 && bucket + 1 < io_stats::buckets_num) {
+                latency_ns >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        std::atomic<uint64_t> _calls { 0 };
+        std::atomic<uint64_t> _reads { 0 };
+        std::atomic<uint64_t> _writes { 0 };
+        std::atomic<uint64_t> _bytes_read { 0 };
+        std::atomic<uint64_t> _bytes_written { 0 };
+        std::atomic<uint64_t> _errors { 0 };
+        std::atomic<uint64_t> _retries { 0 };
+        std::atomic<uint64_t> _latency_total_ns { 0 };
+        std::atomic<uint64_t> _latency_max_ns { 0 };
+        std::atomic<uint64_t> _latency_buckets[io_stats::buckets_num] {};
+    };
+} // namespace detail
+
+} // namespace chappi
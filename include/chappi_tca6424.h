@@ -46,8 +46,8 @@ namespace detail {
 } // namespace detail
 
 template <typename ErrorType = int, ErrorType NoerrorValue = 0,
-    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t>
-class tca6424 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType> {
+    typename DevAddrType = uint8_t, typename AddrType = uint8_t, typename ValueType = uint8_t, typename IoPolicy = dynamic_io>
+class tca6424 final : public chip_base<ErrorType, NoerrorValue, DevAddrType, AddrType, ValueType, IoPolicy> {
     static constexpr auto _chip_name = "TCA6424";
     detail::tca6424_counter _counter;
 
@@ -58,8 +58,9 @@ public:
     {
     }
     tca6424(std::streambuf* buf_ptr = {}, reg_read_fn reg_read = {}, reg_write_fn reg_write = {}, dev_addr_type dev_addr = {})
-        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type> { buf_ptr, reg_read, reg_write, dev_addr }
+        : chip_base<error_type, NoerrorValue, dev_addr_type, addr_type, value_type, IoPolicy> { buf_ptr, reg_read, reg_write, dev_addr }
     {
+        set_name(_chip_name, get_num());
 #if defined(CHAPPI_LOG_ENABLE)
         log_info(__func__);
 #endif
@@ -75,7 +76,12 @@ public:
         return _counter.get_num();
     }
     int get_counts() const noexcept final { return _counter.get_counts(); }
-    std::string get_name() const noexcept final { return get_name(_chip_name, get_num()); }
+    std::string get_name() const noexcept final { return get_name_cstr(); }
+    void setup_cache(cache_mode mode)
+    {
+        setup_cache(mode, 0x0F);
+        set_volatile(0x00, 3);
+    }
     void configure_port(const tca6424_port_data& data) const
     {
 #if defined(CHAPPI_LOG_ENABLE)
@@ -85,7 +91,7 @@ public:
     }
     void configure_port(const tca6424_port_data& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<tca6424, error_type, NoerrorValue, tca6424_port_data, &tca6424::configure_port>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { configure_port(data); });
     }
     void set_port(const tca6424_port_data& data) const
     {
@@ -96,7 +102,7 @@ public:
     }
     void set_port(const tca6424_port_data& data, error_type& error) const noexcept
     {
-        helpers::noexcept_set_function<tca6424, error_type, NoerrorValue, tca6424_port_data, &tca6424::set_port>(this, data, error);
+        helpers::noexcept_invoke<error_type, NoerrorValue>(error, [&] { set_port(data); });
     }
     void get_port(tca6424_port_data& data) const
     {
@@ -0,0 +1,432 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if !defined(CHAPPI_TRACE_CAPACITY)
+#define CHAPPI_TRACE_CAPACITY 4096
+#endif
+
+namespace chappi {
+
+enum class trace_op : uint8_t {
+    read,
+    write,
+    span_begin,
+    span_end
+};
+
+// One bus access or one end of a driver operation span. Records are fixed
+// size so they can be stored as they are and decoded later. Timestamps and
+// durations are steady clock nanoseconds, a span record keeps the id of its
+// name in addr.
+struct trace_record {
+    uint64_t timestamp {};
+    uint32_t duration {};
+    uint32_t chip_id {};
+    trace_op op {};
+    uint8_t failed {};
+    uint16_t dev_addr {};
+    uint32_t addr {};
+    uint32_t value {};
+    uint32_t reserved {};
+};
+
+// Preallocated ring of trace records. Any number of threads may record
+// without locks, the oldest records are overwritten when the ring is full.
+// One reader at a time takes records out with consume(), records that were
+// overwritten before it got to them are counted as dropped.
+class trace_buffer {
+public:
+    explicit trace_buffer(std::size_t capacity)
+        : _mask { _round_up(capacity) - 1 }
+        , _slots { new _slot[_mask + 1] }
+    {
+    }
+    trace_buffer(const trace_buffer&) = delete;
+    trace_buffer& operator=(const trace_buffer&) = delete;
+    std::size_t capacity() const noexcept { return _mask + 1; }
+    void record(const trace_record& record) noexcept
+    {
+        const auto pos = _head.fetch_add(1, std::memory_order_relaxed);
+        auto& slot = _slots[pos & _mask];
+        slot.seq.store(2 * pos + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.words[0].store(record.timestamp, std::memory_order_relaxed);
+        slot.words[1].store(uint64_t(record.duration) | uint64_t(record.chip_id) << 32, std::memory_order_relaxed);
+        slot.words[2].store(uint64_t(record.op) | uint64_t(record.failed) << 8 | uint64_t(record.dev_addr) << 16 | uint64_t(record.addr) << 32,
+            std::memory_order_relaxed);
+        slot.words[3].store(record.value, std::memory_order_relaxed);
+        slot.seq.store(2 * pos + 2, std::memory_order_release);
+    }
+    // Calls fn(const trace_record&) for every record not consumed yet, in
+    // order, and returns how many were passed.
+    template <typename Function>
+    std::size_t consume(Function&& fn)
+    {
+        const auto head = _head.load(std::memory_order_acquire);
+        if (head - _tail > capacity()) {
+            _dropped += head - _tail - capacity();
+            _tail = head - capacity();
+        }
+        std::size_t count {};
+        for (; _tail != head; ++_tail) {
+            trace_record record {};
+            const auto state = _load(_tail, record);
+            if (state == _slot_state::pending) {
+                break;
+            }
+            if (state == _slot_state::lost) {
+                ++_dropped;
+                continue;
+            }
+            fn(record);
+            ++count;
+        }
+        return count;
+    }
+    uint64_t get_dropped() const noexcept { return _dropped; }
+    // The buffer the drivers record into.
+    static trace_buffer& global()
+    {
+        static trace_buffer buffer { CHAPPI_TRACE_CAPACITY };
+        return buffer;
+    }
+
+private:
+    enum class _slot_state {
+        ready,
+        pending,
+        lost
+    };
+    struct _slot {
+        std::atomic<uint64_t> seq { 0 };
+        std::atomic<uint64_t> words[4] {};
+    };
+    static std::size_t _round_up(std::size_t capacity) noexcept
+    {
+        std::size_t size { 1 };
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+    // A slot is pending while its record is still being written and lost
+    // once a newer record took it over.
+    _slot_state _load(uint64_t pos, trace_record& record) const noexcept
+    {
+        const auto& slot = _slots[pos & _mask];
+        const auto seq = slot.seq.load(std::memory_order_acquire);
+        if (seq < 2 * pos + 2) {
+            return _slot_state::pending;
+        }
+        if (seq != 2 * pos + 2) {
+            return _slot_state::lost;
+        }
+        uint64_t words[4];
+        for (std::size_t i {}; i < 4; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) {
+            return _slot_state::lost;
+        }
+        record.timestamp = words[0];
+        record.duration = uint32_t(words[1]);
+        record.chip_id = uint32_t(words[1] >> 32);
+        record.op = trace_op(uint8_t(words[2]));
+        record.failed = uint8_t(words[2] >> 8);
+        record.dev_addr = uint16_t(words[2] >> 16);
+        record.addr = uint32_t(words[2] >> 32);
+        record.value = uint32_t(words[3]);
+        return _slot_state::ready;
+    }
+
+    const std::size_t _mask;
+    const std::unique_ptr<_slot[]> _slots;
+    std::atomic<uint64_t> _head { 0 };
+    uint64_t _tail {};
+    uint64_t _dropped {};
+};
+
+// Names of the traced spans, a span record refers to its name by index.
+class trace_names {
+public:
+    static uint32_t get_id(const char* name)
+    {
+        auto& names = _instance();
+        std::lock_guard<std::mutex> lock { names._mutex };
+        for (std::size_t id {}; id < names._names.size(); ++id) {
+            if (names._names[id] == name) {
+                return uint32_t(id);
+            }
+        }
+        names._names.emplace_back(name);
+        return uint32_t(names._names.size() - 1);
+    }
+    static std::vector<std::string> get_all()
+    {
+        auto& names = _instance();
+        std::lock_guard<std::mutex> lock { names._mutex };
+        return names._names;
+    }
+
+private:
+    static trace_names& _instance()
+    {
+        static trace_names names {};
+        return names;
+    }
+
+    std::mutex _mutex {};
+    std::vector<std::string> _names {};
+};
+
+namespace detail {
+    struct io_timing {
+        uint64_t start_ns {};
+        uint64_t duration_ns {};
+    };
+    inline uint64_t trace_clock_ns() noexcept
+    {
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+                            .count());
+    }
+    inline uint32_t next_trace_id() noexcept
+    {
+        static std::atomic<uint32_t> id { 0 };
+        return id.fetch_add(1, std::memory_order_relaxed);
+    }
+    inline void trace(uint32_t chip_id, trace_op op, bool failed, uint32_t dev_addr, uint32_t addr, uint32_t value,
+        uint64_t timestamp, uint64_t duration) noexcept
+    {
+        trace_record record {};
+        record.timestamp = timestamp;
+        record.duration = uint32_t(duration);
+        record.chip_id = chip_id;
+        record.op = op;
+        record.failed = failed;
+        record.dev_addr = uint16_t(dev_addr);
+        record.addr = addr;
+        record.value = value;
+        trace_buffer::global().record(record);
+    }
+
+    // Records the begin and end of a driver operation, see CHAPPI_TRACE_SPAN.
+    class trace_span {
+    public:
+        trace_span(uint32_t chip_id, uint32_t name_id) noexcept
+            : _chip_id { chip_id }
+            , _name_id { name_id }
+        {
+            trace(_chip_id, trace_op::span_begin, false, 0, _name_id, 0, trace_clock_ns(), 0);
+        }
+        trace_span(const trace_span&) = delete;
+        trace_span& operator=(const trace_span&) = delete;
+        ~trace_span() noexcept
+        {
+            trace(_chip_id, trace_op::span_end, false, 0, _name_id, 0, trace_clock_ns(), 0);
+        }
+
+    private:
+        const uint32_t _chip_id;
+        const uint32_t _name_id;
+    };
+
+    // Formats numbers in decimal, times in microseconds to the nanosecond,
+    // and gives the stream its own flags and precision back afterwards.
+    class trace_stream_format {
+    public:
+        explicit trace_stream_format(std::ostream& stream)
+            : _stream { stream }
+            , _flags { stream.flags() }
+            , _precision { stream.precision() }
+        {
+            _stream.flags(std::ios_base::dec | std::ios_base::fixed);
+            _stream.precision(3);
+        }
+        trace_stream_format(const trace_stream_format&) = delete;
+        trace_stream_format& operator=(const trace_stream_format&) = delete;
+        ~trace_stream_format() noexcept
+        {
+            _stream.flags(_flags);
+            _stream.precision(_precision);
+        }
+
+    private:
+        std::ostream& _stream;
+        const std::ios_base::fmtflags _flags;
+        const std::streamsize _precision;
+    };
+
+    inline void trace_write_chrome_event(const trace_record& record, const std::vector<std::string>& names, bool first, std::ostream& stream)
+    {
+        const trace_stream_format format { stream };
+        const auto timestamp_us = double(record.timestamp) / 1000.0;
+        stream << (first ? "\n" : ",\n") << "{\"pid\":1,\"tid\":" << record.chip_id << ",\"ts\":" << timestamp_us;
+        if (record.op == trace_op::span_begin || record.op == trace_op::span_end) {
+            const auto name = (record.addr < names.size()) ? names[record.addr] : std::string("span-") + std::to_string(record.addr);
+            stream << ",\"ph\":\"" << ((record.op == trace_op::span_begin) ? 'B' : 'E') << "\",\"name\":\"" << name << "\"}";
+            return;
+        }
+        stream << ",\"ph\":\"X\",\"dur\":" << double(record.duration) / 1000.0
+               << ",\"name\":\"" << ((record.op == trace_op::write) ? "write" : "read")
+               << "\",\"args\":{\"dev\":" << record.dev_addr << ",\"reg\":" << record.addr << ",\"val\":" << record.value
+               << ",\"failed\":" << (record.failed ? "true" : "false") << "}}";
+    }
+} // namespace detail
+
+// CHAPPI_TRACE_SPAN(name) inside a driver method records the method as a
+// span around the register accesses it makes.
+#if defined(CHAPPI_TRACE_ENABLE)
+#define CHAPPI_TRACE_SPAN(name)                                        \
+    const ::chappi::detail::trace_span chappi_trace_span               \
+    {                                                                  \
+        this->get_trace_id(), [](const char* span_name) {              \
+            static const auto id = ::chappi::trace_names::get_id(span_name); \
+            return id;                                                 \
+        }(name)                                                        \
+    }
+#else
+#define CHAPPI_TRACE_SPAN(name)
+#endif
+
+// The dump format is the "CHTR" magic, 32-bit version, record size and
+// count of span names, the names as 32-bit length and characters, then the
+// records, all in host byte order.
+inline std::size_t trace_dump(trace_buffer& buffer, std::ostream& stream)
+{
+    const char magic[4] { 'C', 'H', 'T', 'R' };
+    const auto names = trace_names::get_all();
+    const uint32_t header[3] { 2, sizeof(trace_record), uint32_t(names.size()) };
+    stream.write(magic, sizeof(magic));
+    stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+    for (const auto& name : names) {
+        const auto size = uint32_t(name.size());
+        stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        stream.write(name.data(), size);
+    }
+    return buffer.consume([&stream](const trace_record& record) {
+        stream.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    });
+}
+
+inline void trace_format(const trace_record& record, const std::vector<std::string>& names, std::ostream& stream)
+{
+    stream << record.timestamp << " [chip-" << record.chip_id << "] ";
+    if (record.op == trace_op::span_begin || record.op == trace_op::span_end) {
+        stream << ((record.op == trace_op::span_begin) ? "BEGIN " : "END ")
+               << ((record.addr < names.size()) ? names[record.addr] : std::to_string(record.addr)) << '\n';
+        return;
+    }
+    stream << ((record.op == trace_op::write) ? "<W>" : "<R>")
+           << " DEV:" << record.dev_addr << " | REG:" << record.addr << " | VAL:" << record.value << " | " << record.duration << "ns";
+    if (record.failed) {
+        stream << " | FAILED";
+    }
+    stream << '\n';
+}
+
+// Writes the records as Chrome trace-event JSON, which Perfetto and
+// chrome://tracing open directly. Each chip gets its own track, spans nest
+// with the register accesses made inside them.
+inline std::size_t trace_export_chrome(trace_buffer& buffer, std::ostream& stream)
+{
+    const auto names = trace_names::get_all();
+    bool first { true };
+    stream << "{\"traceEvents\":[";
+    const auto count = buffer.consume([&](const trace_record& record) {
+        detail::trace_write_chrome_event(record, names, first, stream);
+        first = false;
+    });
+    stream << "\n]}\n";
+    return count;
+}
+
+namespace detail {
+    template <typename Function>
+    bool trace_read_dump(std::istream& dump, Function&& fn)
+    {
+        char magic[4] {};
+        uint32_t header[3] {};
+        dump.read(magic, sizeof(magic));
+        dump.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (!dump || std::memcmp(magic, "CHTR", sizeof(magic)) != 0 || header[0] != 2 || header[1] != sizeof(trace_record)) {
+            return false;
+        }
+        std::vector<std::string> names(header[2]);
+        for (auto& name : names) {
+            uint32_t size {};
+            dump.read(reinterpret_cast<char*>(&size), sizeof(size));
+            name.resize(size);
+            dump.read(&name[0], size);
+        }
+        if (!dump) {
+            return false;
+        }
+        trace_record record {};
+        while (dump.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+            fn(record, names);
+        }
+        return true;
+    }
+} // namespace detail
+
+// Turns a dump back into text, one line per record. Returns false if the
+// stream is not a dump of this version.
+inline bool trace_decode(std::istream& dump, std::ostream& text)
+{
+    return detail::trace_read_dump(dump, [&text](const trace_record& record, const std::vector<std::string>& names) {
+        trace_format(record, names, text);
+    });
+}
+
+// Converts a dump to Chrome trace-event JSON offline.
+inline bool trace_decode_chrome(std::istream& dump, std::ostream& json)
+{
+    bool first { true };
+    json << "{\"traceEvents\":[";
+    const auto result = detail::trace_read_dump(dump, [&](const trace_record& record, const std::vector<std::string>& names) {
+        detail::trace_write_chrome_event(record, names, first, json);
+        first = false;
+    });
+    json << "\n]}\n";
+    return result;
+}
+
+} // namespace chappi
@@ -0,0 +1,169 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+#include "chappi_base.h"
+
+namespace chappi {
+
+namespace detail {
+    // Asks the register_table a driver declares as registers_table, if any.
+    template <typename ChipType>
+    constexpr auto is_table_volatile(std::size_t addr, int) noexcept
+        -> decltype(ChipType::registers_table::is_volatile(addr))
+    {
+        return ChipType::registers_table::is_volatile(addr);
+    }
+    template <typename ChipType>
+    constexpr bool is_table_volatile(std::size_t, long) noexcept
+    {
+        return false;
+    }
+} // namespace detail
+
+// Defers every register write issued to the chip while the transaction is
+// alive. Repeated writes to one address collapse to the last value, which
+// takes the position of the last write, and commit() sends the collected
+// writes in one batch. Registers marked volatile in the chip cache or in its
+// register table are never collapsed, so action sequences such as a reset
+// pulse reach the chip write by write. Reads of a pending address return the
+// last pending value, so read-modify-write sequences keep working. Running
+// out of capacity raises an error and the transaction then commits nothing.
+// A transaction that is not committed is discarded on destruction.
+template <typename ChipType, std::size_t Capacity = 128>
+class transaction final : detail::write_capture<typename ChipType::addr_type, typename ChipType::value_type> {
+public:
+    using chip_type = ChipType;
+    using error_type = typename chip_type::error_type;
+    using addr_type = typename chip_type::addr_type;
+    using value_type = typename chip_type::value_type;
+    using reg_data_type = typename chip_type::reg_data_type;
+
+    explicit transaction(const chip_type& chip)
+        : _chip { chip }
+    {
+        if (!_chip._attach_capture(this)) {
+            detail::throw_exception(std::logic_error("chappi::transaction: chip already has an active transaction"));
+        }
+    }
+    transaction(const transaction&) = delete;
+    transaction& operator=(const transaction&) = delete;
+    ~transaction() noexcept { rollback(); }
+    void commit()
+    {
+        _detach();
+        if (_overflow) {
+            rollback();
+            _raise_overflow();
+            return;
+        }
+        _flush();
+    }
+    void commit(error_type& error) noexcept
+    {
+        detail::error_latch_scope<error_type> latch {};
+        commit();
+        error = latch.get_error(_chip.no_error_value);
+    }
+    void rollback() noexcept
+    {
+        _detach();
+        _size = 0;
+        _overflow = false;
+    }
+    bool is_active() const noexcept { return _chip._is_capture(this); }
+    std::size_t size() const noexcept { return _size; }
+    static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+private:
+    void capture_write(addr_type addr, value_type value) final
+    {
+        auto pos = _find(addr);
+        if (pos != _size && !_is_volatile(addr)) {
+            for (; pos + 1 < _size; ++pos) {
+                _data[pos] = _data[pos + 1];
+            }
+            --_size;
+        } else if (_size == Capacity) {
+            _overflow = true;
+            _raise_overflow();
+            return;
+        }
+        _data[_size].addr = addr;
+        _data[_size].value = value;
+        ++_size;
+    }
+    bool captured_read(addr_type addr, value_type& value) const noexcept final
+    {
+        const auto pos = _find(addr);
+        if (pos == _size) {
+            return false;
+        }
+        value = _data[pos].value;
+        return true;
+    }
+    // The last pending write to addr, _size when there is none.
+    std::size_t _find(addr_type addr) const noexcept
+    {
+        for (auto pos = _size; pos-- > 0;) {
+            if (_data[pos].addr == addr) {
+                return pos;
+            }
+        }
+        return _size;
+    }
+    bool _is_volatile(addr_type addr) const noexcept
+    {
+        return _chip.is_volatile(addr) || detail::is_table_volatile<chip_type>(std::size_t(addr), 0);
+    }
+    void _raise_overflow() const
+    {
+        _chip.raise_error(std::length_error("chappi::transaction: capacity exceeded"));
+    }
+    void _detach() noexcept
+    {
+        _chip._detach_capture(this);
+    }
+    void _flush()
+    {
+        const auto size = _size;
+        _size = 0;
+        if (size != 0) {
+            _chip._write_batch(_data.data(), size);
+        }
+    }
+
+    const chip_type& _chip;
+    std::array<reg_data_type, Capacity> _data {};
+    std::size_t _size {};
+    bool _overflow {};
+};
+
+} // namespace chappi
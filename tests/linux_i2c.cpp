@@ -0,0 +1,235 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+// The I2C backend against a fake system call layer. The fake records the
+// messages of every I2C_RDWR ioctl and serves reads from a byte-addressed
+// register file, so the tests check the message layout of each transfer.
+
+#include <cerrno>
+#include <cstdio>
+#include <vector>
+#include "chappi.h"
+#include "chappi_linux_i2c.h"
+
+struct recorded_msg {
+  uint16_t addr;
+  uint16_t flags;
+  std::vector<uint8_t> data;
+};
+
+// The system calls of the backend. Every ioctl is recorded, a message that
+// writes sets the register pointer from its first byte and stores the rest,
+// a read message returns bytes from the pointer on.
+struct fake_i2c_sys {
+  static std::vector<std::vector<recorded_msg>> ioctls;
+  static std::vector<uint8_t> memory;
+  static std::size_t value_size;
+  static int fail_errno;
+
+  static void reset(std::size_t size) {
+    ioctls.clear();
+    memory.assign(256 * size, 0);
+    value_size = size;
+    fail_errno = 0;
+  }
+  static int open(const char *, int) noexcept { return 3; }
+  static int close(int) noexcept { return 0; }
+  static int ioctl(int, unsigned long request, void *arg) noexcept {
+    if (request != I2C_RDWR) {
+      errno = EINVAL;
+      return -1;
+    }
+    if (fail_errno != 0) {
+      errno = fail_errno;
+      return -1;
+    }
+    const auto &data = *static_cast<i2c_rdwr_ioctl_data *>(arg);
+    std::vector<recorded_msg> msgs{};
+    std::size_t pointer{};
+    for (__u32 i{}; i < data.nmsgs; ++i) {
+      const auto &msg = data.msgs[i];
+      if (msg.flags & I2C_M_RD) {
+        for (__u16 byte{}; byte < msg.len; ++byte) {
+          msg.buf[byte] = memory[(pointer + byte) % memory.size()];
+        }
+      } else {
+        pointer = msg.buf[0] * value_size;
+        for (__u16 byte{1}; byte < msg.len; ++byte) {
+          memory[(pointer + byte - 1) % memory.size()] = msg.buf[byte];
+        }
+      }
+      msgs.push_back({msg.addr, msg.flags, {msg.buf, msg.buf + msg.len}});
+    }
+    ioctls.push_back(msgs);
+    return 0;
+  }
+};
+
+std::vector<std::vector<recorded_msg>> fake_i2c_sys::ioctls{};
+std::vector<uint8_t> fake_i2c_sys::memory{};
+std::size_t fake_i2c_sys::value_size{1};
+int fake_i2c_sys::fail_errno{};
+
+static bool i2c_ok{true};
+
+static void check(const char *name, bool ok) {
+  std::printf("%-48s %s\n", name, ok ? "ok" : "FAILED");
+  if (!ok) {
+    i2c_ok = false;
+  }
+}
+
+static bool is_msg(const recorded_msg &msg, uint16_t addr, uint16_t flags,
+                   std::size_t size) {
+  return msg.addr == addr && msg.flags == flags && msg.data.size() == size;
+}
+
+using error_type = int;
+static const error_type no_error_v{error_type{0}};
+
+using bus8 = chappi::linux_i2c<error_type, no_error_v, uint8_t, uint8_t,
+                               uint8_t, fake_i2c_sys>;
+using bus16 = chappi::linux_i2c<error_type, no_error_v, uint8_t, uint8_t,
+                                uint16_t, fake_i2c_sys>;
+
+static void test_register_access() {
+  fake_i2c_sys::reset(1);
+  const bus8 bus{3};
+  chappi::tca6424<error_type, no_error_v> chip{};
+  bus.attach(chip, 0x22);
+  fake_i2c_sys::memory[0x05] = 0xA5;
+  uint8_t value{};
+  chip.read(0x05, value);
+  const auto &ioctls = fake_i2c_sys::ioctls;
+  check("read: one ioctl, write and read message",
+        ioctls.size() == 1 && ioctls[0].size() == 2 &&
+            is_msg(ioctls[0][0], 0x22, 0, 1) &&
+            ioctls[0][0].data[0] == 0x05 &&
+            is_msg(ioctls[0][1], 0x22, I2C_M_RD, 1) && value == 0xA5);
+
+  fake_i2c_sys::ioctls.clear();
+  chip.write(0x06, 0x3C);
+  check("write: one ioctl, one message",
+        ioctls.size() == 1 && ioctls[0].size() == 1 &&
+            is_msg(ioctls[0][0], 0x22, 0, 2) &&
+            ioctls[0][0].data[0] == 0x06 && ioctls[0][0].data[1] == 0x3C);
+}
+
+static void test_block_transfers() {
+  fake_i2c_sys::reset(1);
+  const bus8 bus{3};
+  chappi::ltc2991<error_type, no_error_v> chip{};
+  bus.attach(chip, 0x48);
+  const auto &ioctls = fake_i2c_sys::ioctls;
+
+  uint8_t values[100]{};
+  for (std::size_t i{}; i < 100; ++i) {
+    fake_i2c_sys::memory[0x10 + i] = uint8_t(i);
+  }
+  chip.read_block(0x10, values, 8);
+  bool same{true};
+  for (std::size_t i{}; i < 8; ++i) {
+    same = same && values[i] == i;
+  }
+  check("read_block: one ioctl, write and read message",
+        ioctls.size() == 1 && ioctls[0].size() == 2 &&
+            is_msg(ioctls[0][0], 0x48, 0, 1) &&
+            is_msg(ioctls[0][1], 0x48, I2C_M_RD, 8) && same);
+
+  fake_i2c_sys::ioctls.clear();
+  chip.read_block(0x10, values, 100);
+  same = true;
+  for (std::size_t i{}; i < 100; ++i) {
+    same = same && values[i] == i;
+  }
+  check("read_block: one ioctl per block_max registers",
+        ioctls.size() == 2 && ioctls[0].size() == 2 &&
+            is_msg(ioctls[0][1], 0x48, I2C_M_RD, bus8::block_max) &&
+            ioctls[1][0].data[0] == 0x10 + bus8::block_max &&
+            is_msg(ioctls[1][1], 0x48, I2C_M_RD, 100 - bus8::block_max) &&
+            same);
+
+  fake_i2c_sys::ioctls.clear();
+  const uint8_t block[]{1, 2, 3, 4};
+  chip.write_block(0x08, block, 4);
+  check("write_block: one message, address then values",
+        ioctls.size() == 1 && ioctls[0].size() == 1 &&
+            is_msg(ioctls[0][0], 0x48, 0, 5) &&
+            ioctls[0][0].data ==
+                std::vector<uint8_t>({0x08, 1, 2, 3, 4}));
+
+  fake_i2c_sys::ioctls.clear();
+  const chappi::reg_data<uint8_t, uint8_t> batch[]{
+      {0x01, 0xF0}, {0x06, 0x11}, {0x07, 0x22}};
+  chip.write_batch(batch, 3);
+  check("write_batch: one ioctl, one message per register",
+        ioctls.size() == 1 && ioctls[0].size() == 3 &&
+            ioctls[0][0].data == std::vector<uint8_t>({0x01, 0xF0}) &&
+            ioctls[0][1].data == std::vector<uint8_t>({0x06, 0x11}) &&
+            ioctls[0][2].data == std::vector<uint8_t>({0x07, 0x22}));
+
+  fake_i2c_sys::ioctls.clear();
+  chip.get_data();
+  check("ltc2991::get_data: one ioctl",
+        ioctls.size() == 1 && ioctls[0].size() == 2);
+}
+
+static void test_wide_registers() {
+  fake_i2c_sys::reset(2);
+  const bus16 bus{3};
+  chappi::ina219<error_type, no_error_v> chip{};
+  bus.attach(chip, 0x40);
+  const auto &ioctls = fake_i2c_sys::ioctls;
+  chip.configure(0x399F);
+  check("16-bit write: value MSB first",
+        ioctls.size() == 1 &&
+            ioctls[0][0].data == std::vector<uint8_t>({0x00, 0x39, 0x9F}));
+
+  fake_i2c_sys::ioctls.clear();
+  fake_i2c_sys::memory[2 * 0x02] = 0x12;
+  fake_i2c_sys::memory[2 * 0x02 + 1] = 0x34;
+  uint16_t value{};
+  chip.read(0x02, value);
+  check("16-bit read: value MSB first",
+        ioctls.size() == 1 && is_msg(ioctls[0][1], 0x40, I2C_M_RD, 2) &&
+            value == 0x1234);
+}
+
+static void test_errors() {
+  fake_i2c_sys::reset(1);
+  const bus8 bus{3};
+  fake_i2c_sys::fail_errno = EREMOTEIO;
+  uint8_t value{};
+  check("failed ioctl returns errno",
+        bus.read(0x22, 0x05, value) == EREMOTEIO);
+}
+
+int main() {
+  test_register_access();
+  test_block_transfers();
+  test_wide_registers();
+  test_errors();
+  return i2c_ok ? 0 : 1;
+}
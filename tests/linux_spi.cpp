@@ -0,0 +1,250 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+// The SPI backend against a fake system call layer. The fake records the
+// transfers of every SPI_IOC_MESSAGE ioctl and answers reads from a register
+// file, so the tests check how driver calls map onto messages and frames.
+
+#include <cerrno>
+#include <cstdio>
+#include <vector>
+#include "chappi.h"
+#include "chappi_linux_spi.h"
+
+struct recorded_transfer {
+  std::vector<uint8_t> tx;
+  bool read;
+  bool cs_change;
+  uint8_t bits_per_word;
+};
+
+struct recorded_message {
+  unsigned long request;
+  std::vector<recorded_transfer> transfers;
+};
+
+// The system calls of the backend. A read frame is answered with the value
+// of the addressed register, found by decode() of the transmitted frame.
+struct fake_spi_sys {
+  static std::vector<recorded_message> messages;
+  static uint16_t regs[256];
+  static unsigned (*decode)(const uint8_t *frame);
+  static int fail_errno;
+
+  static void reset(unsigned (*decoder)(const uint8_t *)) {
+    messages.clear();
+    for (auto &reg : regs) {
+      reg = 0;
+    }
+    decode = decoder;
+    fail_errno = 0;
+  }
+  static int open(const char *, int) noexcept { return 3; }
+  static int close(int) noexcept { return 0; }
+  static int ioctl(int, unsigned long request, void *arg) noexcept {
+    if (_IOC_TYPE(request) != SPI_IOC_MAGIC || _IOC_NR(request) != 0) {
+      return 0;
+    }
+    if (fail_errno != 0) {
+      errno = fail_errno;
+      return -1;
+    }
+    const auto count = _IOC_SIZE(request) / sizeof(spi_ioc_transfer);
+    const auto transfers = static_cast<const spi_ioc_transfer *>(arg);
+    recorded_message message{request, {}};
+    for (std::size_t i{}; i < count; ++i) {
+      const auto &transfer = transfers[i];
+      const auto tx = reinterpret_cast<const uint8_t *>(transfer.tx_buf);
+      if (transfer.rx_buf != 0) {
+        const auto rx = reinterpret_cast<uint8_t *>(transfer.rx_buf);
+        const auto value = regs[decode(tx) & 0xFF];
+        for (std::size_t byte{}; byte < transfer.len; ++byte) {
+          rx[byte] = 0;
+        }
+        rx[transfer.len - 1] = uint8_t(value);
+        if (transfer.len > 2) {
+          rx[transfer.len - 2] = uint8_t(value >> 8);
+        }
+      }
+      message.transfers.push_back({{tx, tx + transfer.len},
+                                   transfer.rx_buf != 0,
+                                   transfer.cs_change != 0,
+                                   transfer.bits_per_word});
+    }
+    messages.push_back(message);
+    return 0;
+  }
+};
+
+std::vector<recorded_message> fake_spi_sys::messages{};
+uint16_t fake_spi_sys::regs[256]{};
+unsigned (*fake_spi_sys::decode)(const uint8_t *){};
+int fake_spi_sys::fail_errno{};
+
+static bool spi_ok{true};
+
+static void check(const char *name, bool ok) {
+  std::printf("%-48s %s\n", name, ok ? "ok" : "FAILED");
+  if (!ok) {
+    spi_ok = false;
+  }
+}
+
+// One message of count frames of frame_size bytes, the chip select released
+// between frames and kept after the last one.
+static bool is_message(const recorded_message &message, std::size_t count,
+                       std::size_t frame_size, bool read) {
+  if (message.request != SPI_IOC_MESSAGE(count) ||
+      message.transfers.size() != count) {
+    return false;
+  }
+  for (std::size_t i{}; i < count; ++i) {
+    const auto &transfer = message.transfers[i];
+    if (transfer.tx.size() != frame_size || transfer.read != read ||
+        transfer.cs_change != (i + 1 < count) ||
+        transfer.bits_per_word != 8) {
+      return false;
+    }
+  }
+  return true;
+}
+
+using error_type = int;
+static const error_type no_error_v{error_type{0}};
+
+static void test_lmx2594() {
+  fake_spi_sys::reset([](const uint8_t *frame) -> unsigned {
+    return frame[0] & 0x7F;
+  });
+  const chappi::linux_spi<error_type, no_error_v, uint8_t, uint8_t, uint16_t,
+                          fake_spi_sys>
+      bus{3, chappi::spi_frames::lmx2594};
+  chappi::lmx2594<error_type, no_error_v> chip{};
+  bus.attach(chip);
+  const auto &messages = fake_spi_sys::messages;
+
+  chip.reset();
+  const auto defaults = chappi::lmx2594_registers::registers_map_defaults;
+  bool order{messages.size() == 1 &&
+             messages[0].transfers.size() ==
+                 chappi::lmx2594_registers::register_max_num + 2};
+  for (int num{}; order && num < chappi::lmx2594_registers::register_max_num;
+       ++num) {
+    const auto &tx = messages[0].transfers[2 + num].tx;
+    const auto addr = chappi::lmx2594_registers::register_max_num - 1 - num;
+    const auto value = defaults.array[addr];
+    order = tx[0] == addr && tx[1] == uint8_t(value >> 8) &&
+            tx[2] == uint8_t(value);
+  }
+  check("lmx2594::reset: one SPI_IOC_MESSAGE",
+        messages.size() == 1 &&
+            is_message(messages[0],
+                       chappi::lmx2594_registers::register_max_num + 2, 3,
+                       false));
+  check("lmx2594::reset: RESET pulse on R0 first",
+        messages.size() == 1 &&
+            messages[0].transfers[0].tx ==
+                std::vector<uint8_t>({0x00, 0x24, 0x12}) &&
+            messages[0].transfers[1].tx ==
+                std::vector<uint8_t>({0x00, 0x24, 0x10}));
+  check("lmx2594::reset: frames from R112 down to R0", order);
+
+  fake_spi_sys::messages.clear();
+  chip.set_output_power({chappi::lmx2594_output::outa, 31});
+  chip.set_n_divider(100);
+  chip.update_changes();
+  check("lmx2594::update_changes: one SPI_IOC_MESSAGE",
+        messages.size() == 1 &&
+            is_message(messages[0], messages[0].transfers.size(), 3, false) &&
+            messages[0].transfers.size() > 1);
+  std::vector<unsigned> addrs{};
+  for (const auto &transfer : messages.back().transfers) {
+    addrs.push_back(transfer.tx[0]);
+  }
+  check("lmx2594::update_changes: R45, R44, R36, R34",
+        addrs == std::vector<unsigned>({45, 44, 36, 34}));
+
+  fake_spi_sys::messages.clear();
+  fake_spi_sys::regs[110] = 2 << 9;
+  const bool locked = chip.is_locked();
+  check("lmx2594::is_locked: read frame of R110",
+        messages.size() == 1 && is_message(messages[0], 1, 3, true) &&
+            messages[0].transfers[0].tx ==
+                std::vector<uint8_t>({0x80 | 110, 0x00, 0x00}) &&
+            locked);
+}
+
+static void test_ltc6953() {
+  fake_spi_sys::reset([](const uint8_t *frame) -> unsigned {
+    return frame[0] >> 1;
+  });
+  const chappi::linux_spi<error_type, no_error_v, uint8_t, uint8_t, uint8_t,
+                          fake_spi_sys>
+      bus{3, chappi::spi_frames::ltc6953};
+  chappi::ltc6953<error_type, no_error_v> chip{};
+  bus.attach(chip);
+  const auto &messages = fake_spi_sys::messages;
+
+  fake_spi_sys::regs[0x02] = 0x08;
+  uint8_t value{};
+  chip.read(0x02, value);
+  check("ltc6953 read: address and R/W bit",
+        messages.size() == 1 && is_message(messages[0], 1, 2, true) &&
+            messages[0].transfers[0].tx ==
+                std::vector<uint8_t>({0x02 << 1 | 0x01, 0x00}) &&
+            value == 0x08);
+
+  fake_spi_sys::messages.clear();
+  chip.write(0x03, 0xA5);
+  check("ltc6953 write: address and R/W bit",
+        messages.size() == 1 && is_message(messages[0], 1, 2, false) &&
+            messages[0].transfers[0].tx ==
+                std::vector<uint8_t>({0x03 << 1, 0xA5}));
+}
+
+static void test_ad5621() {
+  fake_spi_sys::reset([](const uint8_t *) -> unsigned { return 0; });
+  const chappi::linux_spi<error_type, no_error_v, uint8_t, uint8_t, uint16_t,
+                          fake_spi_sys>
+      bus{3, chappi::spi_frames::ad5621};
+  chappi::ad5621<error_type, no_error_v> chip{};
+  bus.attach(chip);
+  const auto &messages = fake_spi_sys::messages;
+  chip.write(0x00, 0x1234);
+  check("ad5621 write: 16-bit data word without address",
+        messages.size() == 1 && is_message(messages[0], 1, 2, false) &&
+            messages[0].transfers[0].tx ==
+                std::vector<uint8_t>({0x12, 0x34}));
+
+  fake_spi_sys::fail_errno = EIO;
+  check("failed ioctl returns errno", bus.write(0, 0, 0x1234) == EIO);
+}
+
+int main() {
+  test_lmx2594();
+  test_ltc6953();
+  test_ad5621();
+  return spi_ok ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+// Retry backoff of a thread-safe chip. A bus access that fails and backs off
+// must not hold the chip: another thread reaches the chip while the first
+// one waits for its retry.
+
+#define CHAPPI_THREAD_SAFE
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include "chappi.h"
+#include "chappi_sim.h"
+
+using error_type = int;
+static const error_type no_error_v{error_type{0}};
+
+static const auto backoff = std::chrono::milliseconds(500);
+
+static bool retry_ok{true};
+
+// Runs writer on a thread whose first bus access fails and backs off, and
+// reader on this thread once the backoff has started. The reader must be
+// done before the writer retries.
+template <typename ChipType, typename DeviceType, typename Writer,
+          typename Reader>
+void backoff_test(const char *name, ChipType &chip, DeviceType &device,
+                  Writer &&writer, Reader &&reader) {
+  std::atomic<bool> backing_off{false};
+  std::atomic<bool> writer_done{false};
+  chappi::retry_policy<error_type> policy{};
+  policy.attempts = 2;
+  policy.backoff = backoff;
+  policy.backoff_max = backoff;
+  policy.is_retryable = [&](error_type) {
+    backing_off = true;
+    return true;
+  };
+  chip.set_retry_policy(policy);
+  device.inject_error(-1);
+  std::thread thread{[&] {
+    writer();
+    writer_done = true;
+  }};
+  while (!backing_off) {
+    std::this_thread::yield();
+  }
+  const auto start = std::chrono::steady_clock::now();
+  reader();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const bool ok = !writer_done && elapsed < backoff;
+  thread.join();
+  std::printf("%-48s %8.3f ms %s\n", name,
+              std::chrono::duration<double, std::milli>(elapsed).count(),
+              ok ? "ok" : "FAILED");
+  if (!ok) {
+    retry_ok = false;
+  }
+}
+
+int main() {
+  {
+    chappi::ina219<error_type, no_error_v> chip{};
+    chappi::sim_ina219<error_type, no_error_v> device{};
+    device.attach(chip);
+    backoff_test(
+        "ina219::get_bus_voltage during configure", chip, device,
+        [&] { chip.configure(0x399F); }, [&] { chip.get_bus_voltage(); });
+  }
+  {
+    chappi::lmx2594<error_type, no_error_v> chip{};
+    chappi::sim_lmx2594<error_type, no_error_v> device{};
+    device.attach(chip);
+    chip.reset();
+    backoff_test(
+        "lmx2594::is_locked during update_output_power", chip, device,
+        [&] { chip.update_output_power({chappi::lmx2594_output::outa, 31}); },
+        [&] { chip.is_locked(); });
+  }
+  return retry_ok ? 0 : 1;
+}
@@ -0,0 +1,521 @@
+/*
+
+MIT License
+
+Copyright (c) 2019 Alexander Chernenko (achernenko@mail.ru)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+// Bus traffic budgets of the driver methods. Each public method of every
+// driver runs once against a simulated device, and its transactions and
+// register bytes are checked against the budget. A method over budget, or
+// one that fails, fails the test and prints its transaction sequence. Pass
+// a driver name to check only that driver.
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include "chappi.h"
+#include "chappi_sim.h"
+
+using error_type = int;
+static const error_type no_error_v{error_type{0}};
+
+static const char *op_name(chappi::sim_op op) {
+  switch (op) {
+  case chappi::sim_op::read:
+    return "read";
+  case chappi::sim_op::write:
+    return "write";
+  case chappi::sim_op::read_block:
+    return "read_block";
+  case chappi::sim_op::write_block:
+    return "write_block";
+  case chappi::sim_op::write_batch:
+    return "write_batch";
+  }
+  return "";
+}
+
+static bool traffic_ok{true};
+
+// Runs fn once, checks its bus traffic on device against the budget and
+// prints the transaction sequence when it is exceeded or fn fails.
+template <typename DeviceType, typename Function>
+void traffic(const char *name, DeviceType &device,
+             std::size_t max_transactions, std::size_t max_bytes,
+             Function &&fn) {
+  device.reset_counters();
+  device.set_recording(true);
+  const char *failure{};
+  try {
+    fn();
+  } catch (const std::exception &e) {
+    failure = e.what();
+  }
+  device.set_recording(false);
+  const auto transactions = device.get_transactions();
+  const auto bytes = device.get_bytes();
+  const bool ok =
+      !failure && transactions <= max_transactions && bytes <= max_bytes;
+  std::printf("%-48s %5zu/%-5zu transactions %5zu/%-5zu bytes %s\n", name,
+              transactions, max_transactions, bytes, max_bytes,
+              ok ? "ok" : (failure ? "FAILED" : "OVER BUDGET"));
+  if (!ok) {
+    if (failure) {
+      std::printf("    %s\n", failure);
+    }
+    const auto &record = device.get_record();
+    const std::size_t max_printed{32};
+    for (std::size_t i{}; i < record.size() && i < max_printed; ++i) {
+      const auto &transaction = record[i];
+      std::printf("    %-12s 0x%04x x%zu%s\n", op_name(transaction.op),
+                  unsigned(transaction.addr), transaction.count,
+                  transaction.failed ? " failed" : "");
+    }
+    if (record.size() > max_printed) {
+      std::printf("    ... %zu more\n", record.size() - max_printed);
+    }
+    traffic_ok = false;
+  }
+}
+
+// Reports a check that is not about the amount of traffic.
+static void check(const char *name, bool ok) {
+  std::printf("%-48s %s\n", name, ok ? "ok" : "FAILED");
+  if (!ok) {
+    traffic_ok = false;
+  }
+}
+
+static void test_ad5621() {
+  chappi::ad5621<error_type, no_error_v> chip{};
+  chappi::sim_ad5621<error_type, no_error_v> device{};
+  device.attach(chip);
+  traffic("ad5621::set_value", device, 1, 2, [&] { chip.set_value(100); });
+}
+
+static void test_adn4600() {
+  chappi::adn4600<error_type, no_error_v> chip{};
+  chappi::sim_adn4600<error_type, no_error_v> device{};
+  device.attach(chip);
+  traffic("adn4600::reset", device, 1, 2, [&] { chip.reset(); });
+  traffic("adn4600::xpt_config", device, 1, 2,
+          [&] { chip.xpt_config({1, 2}); });
+  traffic("adn4600::xpt_update", device, 1, 2, [&] { chip.xpt_update(); });
+}
+
+static void test_hmc987() {
+  chappi::hmc987<error_type, no_error_v> chip{};
+  chappi::sim_hmc987<error_type, no_error_v> device{};
+  device.attach(chip);
+  traffic("hmc987::init", device, 1, 1, [&] { chip.init(); });
+  traffic("hmc987::read_id", device, 1, 1, [&] { chip.read_id(); });
+  traffic("hmc987::chip_enable", device, 1, 1,
+          [&] { chip.chip_enable(true); });
+  traffic("hmc987::is_enabled", device, 2, 2, [&] { chip.is_enabled(); });
+  traffic("hmc987::enable_buffers", device, 1, 1, [&] {
+    chip.enable_buffers(chappi::hmc987_outputs::outs_bitmask::All);
+  });
+  traffic("hmc987::state_buffers", device, 2, 2, [&] {
+    chappi::hmc987_outputs::outs_bitmask bitmask{};
+    chip.state_buffers(bitmask);
+  });
+  traffic("hmc987::set_gain", device, 1, 1,
+          [&] { chip.set_gain(chappi::hmc987_gain::zero_dBm); });
+  traffic("hmc987::get_gain", device, 2, 2, [&] { chip.get_gain(); });
+}
+
+static void test_hmc988() {
+  chappi::hmc988<error_type, no_error_v> chip{};
+  chappi::sim_hmc988<error_type, no_error_v> device{};
+  device.attach(chip);
+  traffic("hmc988::reset", device, 1, 2, [&] { chip.reset(); });
+  traffic("hmc988::read_id", device, 2, 4, [&] { chip.read_id(); });
+  traffic("hmc988::chip_enable", device, 3, 6,
+          [&] { chip.chip_enable(true); });
+  traffic("hmc988::is_enabled", device, 2, 4, [&] { chip.is_enabled(); });
+  traffic("hmc988::rx_buffer_enable", device, 3, 6,
+          [&] { chip.rx_buffer_enable(true); });
+  traffic("hmc988::is_rx_buffer_enabled", device, 2, 4,
+          [&] { chip.is_rx_buffer_enabled(); });
+  traffic("hmc988::output_buffer_enable", device, 3, 6,
+          [&] { chip.output_buffer_enable(true); });
+  traffic("hmc988::is_output_buffer_enabled", device, 2, 4,
+          [&] { chip.is_output_buffer_enabled(); });
+  traffic("hmc988::divider_core_enable", device, 3, 6,
+          [&] { chip.divider_core_enable(true); });
+  traffic("hmc988::is_divider_core_enabled", device, 2, 4,
+          [&] { chip.is_divider_core_enabled(); });
+  traffic("hmc988::delay_line_enable", device, 3, 6,
+          [&] { chip.delay_line_enable(true); });
+  traffic("hmc988::is_delay_line_enable", device, 2, 4,
+          [&] { chip.is_delay_line_enable(); });
+  traffic("hmc988::regulator_bypass", device, 3, 6,
+          [&] { chip.regulator_bypass(true); });
+  traffic("hmc988::is_regulator_bypass", device, 2, 4,
+          [&] { chip.is_regulator_bypass(); });
+  traffic("hmc988::set_divide_ratio", device, 3, 6,
+          [&] { chip.set_divide_ratio(chappi::hmc988_divide_ratio::div4); });
+  traffic("hmc988::get_divide_ratio", device, 2, 4,
+          [&] { chip.get_divide_ratio(); });
+  traffic("hmc988::set_tx_buffer_swing", device, 3, 6, [&] {
+    chip.set_tx_buffer_swing(
+        chappi::hmc988_tx_buffer_swing::single_ended_800mVpp);
+  });
+  traffic("hmc988::get_tx_buffer_swing", device, 2, 4,
+          [&] { chip.get_tx_buffer_swing(); });
+  traffic("hmc988::force_gpo", device, 3, 6, [&] {
+    chip.force_gpo({chappi::hmc988_gpo_force_mode::on_gpo_only, true});
+  });
+  traffic("hmc988::is_gpo_forced", device, 2, 4, [&] {
+    chip.is_gpo_forced(chappi::hmc988_gpo_force_mode::on_gpo_only);
+  });
+  traffic("hmc988::set_delay_line_setpoint", device, 1, 2,
+          [&] { chip.set_delay_line_setpoint(30); });
+  traffic("hmc988::get_delay_line_setpoint", device, 2, 4,
+          [&] { chip.get_delay_line_setpoint(); });
+}
+
+static void test_ina219() {
+  chappi::ina219<error_type, no_error_v> chip{};
+  chappi::sim_ina219<error_type, no_error_v> device{};
+  device.attach(chip);
+  traffic("ina219::configure", device, 1, 2,
+          [&] { chip.configure(0x399F); });
+  traffic("ina219::reset", device, 2, 4, [&] { chip.reset(); });
+  traffic("ina219::get_shunt_voltage", device, 1, 2,
+          [&] { chip.get_shunt_voltage(); });
+  traffic("ina219::get_bus_voltage", device, 1, 2,
+          [&] { chip.get_bus_voltage(); });
+  // The reset bit is written through even with a write-back cache.
+  chip.setup_cache(chappi::cache_mode::write_back);
+  traffic("ina219::reset, write-back cache", device, 2, 4, [&] {
+    chip.reset();
+    chip.flush_cache();
+  });
+  const auto &record = device.get_record();
+  check("ina219::reset, write-back cache, reset sent",
+        !record.empty() && record.back().op == chappi::sim_op::write &&
+            record.back().addr == 0x00 && (device.peek(0x00) & 0x8000));
+}
+
+static void test_lmx2594() {
+  chappi::lmx2594<error_type, no_error_v> chip{};
+  chappi::sim_lmx2594<error_type, no_error_v> device{};
+  device.attach(chip);
+  chappi::lmx2594_output_frequency frequency{};
+  frequency.output = chappi::lmx2594_output::outa;
+  frequency.reference = 100e6;
+  frequency.frequency = 2.45e9;
+  const auto outa = chappi::lmx2594_output::outa;
+  traffic("lmx2594::reset", device, 1, 230, [&] { chip.reset(); });
+  // The reset pulse on R0 survives a transaction.
+  traffic("lmx2594::reset, in a transaction", device, 1, 230, [&] {
+    chappi::transaction<decltype(chip)> transaction{chip};
+    chip.reset();
+    transaction.commit();
+  });
+  traffic("lmx2594::chip_enable", device, 1, 2,
+          [&] { chip.chip_enable(true); });
+  traffic("lmx2594::is_enabled", device, 1, 2, [&] { chip.is_enabled(); });
+  traffic("lmx2594::vco_calibrate", device, 1, 2,
+          [&] { chip.vco_calibrate(); });
+  traffic("lmx2594::is_locked", device, 1, 2, [&] { chip.is_locked(); });
+  traffic("lmx2594::wait_lock_detect", device, 1, 2,
+          [&] { chip.wait_lock_detect(); });
+  traffic("lmx2594::is_output_enabled", device, 1, 2,
+          [&] { chip.is_output_enabled(outa); });
+  // Setters only change the shadow map, update_changes() writes them.
+  traffic("lmx2594::set_output_enabled", device, 0, 0,
+          [&] { chip.set_output_enabled({outa, true}); });
+  traffic("lmx2594::set_output_power", device, 0, 0,
+          [&] { chip.set_output_power({outa, 31}); });
+  traffic("lmx2594::set_output_mux", device, 0, 0,
+          [&] { chip.set_output_mux(chappi::lmx2594_output_a_mux::vco); });
+  traffic("lmx2594::set_channel_divider", device, 0, 0, [&] {
+    chip.set_channel_divider(chappi::lmx2594_channel_divider::div4);
+  });
+  traffic("lmx2594::set_charge_pump_gain", device, 0, 0, [&] {
+    chip.set_charge_pump_gain(chappi::lmx2594_charge_pump_gain::current_6_mA);
+  });
+  traffic("lmx2594::set_doubler", device, 0, 0,
+          [&] { chip.set_doubler(chappi::lmx2594_doubler::disabled); });
+  traffic("lmx2594::set_pre_divider", device, 0, 0,
+          [&] { chip.set_pre_divider(1); });
+  traffic("lmx2594::set_multiplier", device, 0, 0,
+          [&] { chip.set_multiplier(chappi::lmx2594_multiplier::bypass); });
+  traffic("lmx2594::set_divider", device, 0, 0, [&] { chip.set_divider(1); });
+  traffic("lmx2594::set_n_divider", device, 0, 0,
+          [&] { chip.set_n_divider(100); });
+  traffic("lmx2594::set_fractional_numerator", device, 0, 0,
+          [&] { chip.set_fractional_numerator(1); });
+  traffic("lmx2594::set_fractional_denomerator", device, 0, 0,
+          [&] { chip.set_fractional_denomerator(1000); });
+  traffic("lmx2594::set_lock_detect", device, 0, 0, [&] {
+    chip.set_lock_detect(chappi::lmx2594_lock_detect::vco_vtune_status);
+  });
+  traffic("lmx2594::set_lock_detect_mux", device, 0, 0, [&] {
+    chip.set_lock_detect_mux(chappi::lmx2594_lock_detect_mux::lock_detect);
+  });
+  traffic("lmx2594::set_phase_detector_delay", device, 0, 0,
+          [&] { chip.set_phase_detector_delay(10000000000ull); });
+  traffic("lmx2594::set_vco_calibration_divider", device, 0, 0,
+          [&] { chip.set_vco_calibration_divider(100000000ull); });
+  traffic("lmx2594::set_mash_order", device, 0, 0,
+          [&] { chip.set_mash_order(chappi::lmx2594_mash_order::frac3); });
+  traffic("lmx2594::set_high_pd_frequency_calibration", device, 0, 0,
+          [&] { chip.set_high_pd_frequency_calibration(100000000u); });
+  traffic("lmx2594::set_low_pd_frequency_calibration", device, 0, 0,
+          [&] { chip.set_low_pd_frequency_calibration(100000000u); });
+  traffic("lmx2594::update_changes", device, 1, 40,
+          [&] { chip.update_changes(); });
+  traffic("lmx2594::update_output_enabled", device, 1, 2,
+          [&] { chip.update_output_enabled({outa, true}); });
+  traffic("lmx2594::update_output_power", device, 2, 4,
+          [&] { chip.update_output_power({outa, 31}); });
+  traffic("lmx2594::update_output_mux", device, 1, 2, [&] {
+    chip.update_output_mux(chappi::lmx2594_output_a_mux::chdiv);
+  });
+  traffic("lmx2594::update_channel_divider", device, 2, 4, [&] {
+    chip.update_channel_divider(chappi::lmx2594_channel_divider::div2);
+  });
+  traffic("lmx2594::update_charge_pump_gain", device, 1, 2, [&] {
+    chip.update_charge_pump_gain(
+        chappi::lmx2594_charge_pump_gain::current_15_mA);
+  });
+  traffic("lmx2594::update_doubler", device, 1, 2,
+          [&] { chip.update_doubler(chappi::lmx2594_doubler::disabled); });
+  traffic("lmx2594::update_pre_divider", device, 1, 2,
+          [&] { chip.update_pre_divider(1); });
+  traffic("lmx2594::update_multiplier", device, 1, 2, [&] {
+    chip.update_multiplier(chappi::lmx2594_multiplier::bypass);
+  });
+  traffic("lmx2594::update_divider", device, 1, 2,
+          [&] { chip.update_divider(1); });
+  traffic("lmx2594::update_n_divider", device, 2, 4,
+          [&] { chip.update_n_divider(100); });
+  traffic("lmx2594::update_fractional_numerator", device, 2, 4,
+          [&] { chip.update_fractional_numerator(1); });
+  traffic("lmx2594::update_fractional_denomerator", device, 2, 4,
+          [&] { chip.update_fractional_denomerator(1000); });
+  traffic("lmx2594::update_lock_detect", device, 1, 2, [&] {
+    chip.update_lock_detect(chappi::lmx2594_lock_detect::vco_vtune_status);
+  });
+  traffic("lmx2594::update_lock_detect_mux", device, 1, 2, [&] {
+    chip.update_lock_detect_mux(
+        chappi::lmx2594_lock_detect_mux::lock_detect);
+  });
+  traffic("lmx2594::update_phase_detector_delay", device, 1, 2,
+          [&] { chip.update_phase_detector_delay(10000000000ull); });
+  traffic("lmx2594::update_vco_calibration_divider", device, 2, 4,
+          [&] { chip.update_vco_calibration_divider(100000000ull); });
+  traffic("lmx2594::update_mash_order", device, 1, 2, [&] {
+    chip.update_mash_order(chappi::lmx2594_mash_order::frac3);
+  });
+  traffic("lmx2594::update_high_pd_frequency_calibration", device, 1, 2,
+          [&] { chip.update_high_pd_frequency_calibration(100000000u); });
+  traffic("lmx2594::update_low_pd_frequency_calibration", device, 1, 2,
+          [&] { chip.update_low_pd_frequency_calibration(100000000u); });
+  // Calculations on the shadow map stay off the bus.
+  traffic("lmx2594::get_n_divider_min", device, 0, 0,
+          [&] { chip.get_n_divider_min(10000000000ull); });
+  traffic("lmx2594::get_osc_frequency_max", device, 0, 0,
+          [&] { chip.get_osc_frequency_max(); });
+  traffic("lmx2594::get_pd_frequency_max", device, 0, 0,
+          [&] { chip.get_pd_frequency_max(); });
+  traffic("lmx2594::get_pd_frequency_min", device, 0, 0,
+          [&] { chip.get_pd_frequency_min(); });
+  traffic("lmx2594::get_vco_frequency_max", device, 0, 0,
+          [&] { chip.get_vco_frequency_max(); });
+  traffic("lmx2594::get_channel_divider", device, 0, 0,
+          [&] { chip.get_channel_divider(2450000000ull, 100e6); });
+  traffic("lmx2594::find_num_denom", device, 0, 0, [&] {
+    uint32_t numerator{};
+    uint32_t denomerator{};
+    chip.find_num_denom(0.123456789, numerator, denomerator);
+  });
+  traffic("lmx2594::is_integer_mode", device, 0, 0,
+          [&] { chip.is_integer_mode(); });
+  traffic("lmx2594::set_frequency", device, 4, 44,
+          [&] { chip.set_frequency(frequency); });
+  traffic("lmx2594::get_registers_map", device, 0, 0,
+          [&] { chip.get_registers_map(); });
+  // Switching back to a saved profile writes the differing registers and
+  // R0, not the whole map.
+  const auto profile = chip.get_registers_map();
+  auto other_frequency = frequency;
+  other_frequency.frequency = 3.1e9;
+  chip.set_frequency(other_frequency);
+  traffic("lmx2594::update_registers_map", device, 1, 4,
+          [&] { chip.update_registers_map(profile); });
+  chappi::lmx2594_registers::registers_update registers{};
+  registers.set_changed(44, 45);
+  traffic("lmx2594::update_registers_map, dump profile", device, 1, 6,
+          [&] { chip.update_registers_map(profile, registers); });
+  chappi::register_images_writer writer{};
+  writer.add("LMX2594", "profile", 0, 0, profile.array, 107, true, {0});
+  const auto image_data = writer.get_data();
+  const chappi::register_images images{image_data.data(), image_data.size()};
+  const auto image = images.find("LMX2594", 0, "profile");
+  traffic("chappi::load_image, lmx2594", device, 1, 214,
+          [&] { chappi::load_image(chip, image); });
+}
+
+static void test_ltc2991() {
+  chappi::ltc2991<error_type, no_error_v> chip{};
+  chappi::sim_ltc2991<error_type, no_error_v> device{};
+  device.attach(chip);
+  traffic("ltc2991::enable_all_channels", device, 2, 2,
+          [&] { chip.enable_all_channels(); });
+  traffic("ltc2991::repeated_mode", device, 2, 2,
+          [&] { chip.repeated_mode(true); });
+  traffic("ltc2991::get_data", device, 1, 18, [&] { chip.get_data(); });
+  traffic("ltc2991::get_voltage", device, 2, 2,
+          [&] { chip.get_voltage(chappi::ltc2991_channel::_1); });
+  traffic("ltc2991::get_temperature", device, 2, 2,
+          [&] { chip.get_temperature(); });
+  // A block read running past the last register reads zeros.
+  uint8_t values[4]{0xFF, 0xFF, 0xFF, 0xFF};
+  chip.read_block(0x1C, values, 4);
+  check("ltc2991 model, read past 0x1D", values[2] == 0 && values[3] == 0);
+}
+
+static void test_ltc6953() {
+  chappi::ltc6953<error_type, no_error_v> chip{};
+  chappi::sim_ltc6953<error_type, no_error_v> device{};
+  device.attach(chip);
+  const auto out1 = chappi::ltc6953_output::out1;
+  traffic("ltc6953::reset", device, 3, 3, [&] { chip.reset(); });
+  // The POR pulse on h02 survives a transaction.
+  traffic("ltc6953::reset, in a transaction", device, 2, 3, [&] {
+    chappi::transaction<decltype(chip)> transaction{chip};
+    chip.reset();
+    transaction.commit();
+  });
+  traffic("ltc6953::chip_enable", device, 2, 2,
+          [&] { chip.chip_enable(true); });
+  traffic("ltc6953::is_enabled", device, 1, 1, [&] { chip.is_enabled(); });
+  traffic("ltc6953::is_vco_valid", device, 1, 1,
+          [&] { chip.is_vco_valid(); });
+  traffic("ltc6953::set_output_inversion", device, 2, 2,
+          [&] { chip.set_output_inversion({out1, true}); });
+  traffic("ltc6953::set_output_powerdown", device, 2, 2, [&] {
+    chip.set_output_powerdown(
+        {out1, chappi::ltc6953_output_powerdown_mode::normal});
+  });
+  traffic("ltc6953::set_digital_delay", device, 3, 3, [&] {
+    chappi::ltc6953_digital_delay delay{};
+    delay.output = out1;
+    delay.delay = 0x123;
+    chip.set_digital_delay(delay);
+  });
+  traffic("ltc6953::set_analog_delay", device, 1, 1, [&] {
+    chappi::ltc6953_analog_delay delay{};
+    delay.output = out1;
+    delay.delay = 10;
+    chip.set_analog_delay(delay);
+  });
+  traffic("ltc6953::set_divider", device, 1, 1, [&] {
+    chappi::ltc6953_divider divider{};
+    divider.output = out1;
+    divider.divider = 64;
+    chip.set_divider(divider);
+  });
+  traffic("ltc6953::set_output_sync_mode", device, 2, 2, [&] {
+    chip.set_output_sync_mode(
+        {out1, chappi::ltc6953_sysref_mode::gated_pulses, true});
+  });
+  traffic("ltc6953::sync_request", device, 3, 3,
+          [&] { chip.sync_request(); });
+  traffic("ltc6953::set_sync_mode", device, 2, 2, [&] {
+    chip.set_sync_mode({chappi::ltc6953_srq_mode::sysref,
+                        chappi::ltc6953_sysref_pulse_count::one_pulse,
+                        false});
+  });
+  traffic("ltc6953::set_input_buffer", device, 2, 2,
+          [&] { chip.set_input_buffer(true); });
+  chappi::ltc6953_registers::registers_map from{};
+  auto to = from;
+  to.array[0x04] = 0x21;
+  to.array[0x0B] = 0x10;
+  traffic("ltc6953::update_registers_map", device, 1, 2,
+          [&] { chip.update_registers_map(from, to); });
+  chappi::ltc6953_registers::registers_update registers{};
+  registers.set_changed(0x04, 0x0B);
+  traffic("ltc6953::update_registers_map, dump profile", device, 1, 2,
+          [&] { chip.update_registers_map(to, registers); });
+}
+
+static void test_si57x() {
+  chappi::si57x<error_type, no_error_v> chip{};
+  chappi::sim_si57x<error_type, no_error_v> device{};
+  device.attach(chip);
+  traffic("si57x::reset", device, 1, 1, [&] { chip.reset(); });
+  traffic("si57x::calib_fxtal", device, 1, 12,
+          [&] { chip.calib_fxtal(156.25e6); });
+  traffic("si57x::set_fxtal", device, 0, 0,
+          [&] { chip.set_fxtal(chip.get_fxtal()); });
+  traffic("si57x::set_freq", device, 1, 12, [&] { chip.set_freq(100e6); });
+  traffic("si57x::get_freq", device, 1, 12, [&] { chip.get_freq(); });
+  traffic("si57x::freeze_dco", device, 1, 1,
+          [&] { chip.freeze_dco(true); });
+  traffic("si57x::apply_freq", device, 1, 1, [&] { chip.apply_freq(); });
+}
+
+static void test_tca6424() {
+  chappi::tca6424<error_type, no_error_v> chip{};
+  chappi::sim_tca6424<error_type, no_error_v> device{};
+  device.attach(chip);
+  traffic("tca6424::configure_port", device, 1, 1,
+          [&] { chip.configure_port({chappi::tca6424_port::_1, 0x0F}); });
+  traffic("tca6424::set_port", device, 1, 1,
+          [&] { chip.set_port({chappi::tca6424_port::_1, 0x5A}); });
+  traffic("tca6424::get_port", device, 1, 1,
+          [&] { chip.get_port(chappi::tca6424_port::_1); });
+}
+
+struct driver_test {
+  const char *name;
+  void (*run)();
+};
+
+static const driver_test driver_tests[]{
+    {"ad5621", test_ad5621},   {"adn4600", test_adn4600},
+    {"hmc987", test_hmc987},   {"hmc988", test_hmc988},
+    {"ina219", test_ina219},   {"lmx2594", test_lmx2594},
+    {"ltc2991", test_ltc2991}, {"ltc6953", test_ltc6953},
+    {"si57x", test_si57x},     {"tca6424", test_tca6424},
+};
+
+int main(int argc, char *argv[]) {
+  bool found{argc < 2};
+  for (const auto &test : driver_tests) {
+    if (argc < 2 || std::strcmp(argv[1], test.name) == 0) {
+      test.run();
+      found = true;
+    }
+  }
+  if (!found) {
+    std::printf("unknown driver %s\n", argv[1]);
+    return 1;
+  }
+  return traffic_ok ? 0 : 1;
+}